@@ -0,0 +1,351 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace ds
+{
+
+// Default allocator of Array. Memory comes from malloc so that trivially relocatable buffers can be
+// grown with realloc.
+template <typename T>
+class HeapAllocator
+{
+  public:
+    using value_type = T;
+    // Stateless, so a moved-to Array can always free the buffer it takes over.
+    using propagate_on_container_move_assignment = std::true_type;
+
+    HeapAllocator() = default;
+
+    template <typename U>
+    HeapAllocator(const HeapAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        void* data = std::malloc(n * sizeof(T));
+        if (data == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(data);
+    }
+
+    void deallocate(T* data, size_t) noexcept
+    {
+        std::free(data);
+    }
+
+    // Only valid for trivially relocatable T: the bytes are moved, no constructor is run.
+    T* reallocate(T* data, size_t, size_t newCount)
+    {
+        void* newData = std::realloc(static_cast<void*>(data), newCount * sizeof(T));
+        if (newData == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(newData);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const HeapAllocator<T>&, const HeapAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const HeapAllocator<T>&, const HeapAllocator<U>&)
+{
+    return false;
+}
+
+// Opt-in allocator for big buffers: blocks of at least HUGE_PAGE_SIZE are aligned and padded to
+// whole huge pages and marked for transparent huge pages, cutting TLB misses on large scans.
+// Smaller blocks come from malloc as with HeapAllocator.
+template <typename T>
+class HugePageAllocator
+{
+  public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    constexpr static size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    HugePageAllocator() = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        size_t bytes = n * sizeof(T);
+        if (bytes < HUGE_PAGE_SIZE)
+        {
+            return HeapAllocator<T>().allocate(n);
+        }
+
+        bytes = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        void* data = nullptr;
+        if (posix_memalign(&data, HUGE_PAGE_SIZE, bytes) != 0)
+        {
+            throw std::bad_alloc();
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // Only a hint: without transparent huge page support the buffer uses regular pages.
+        madvise(data, bytes, MADV_HUGEPAGE);
+#endif
+        return static_cast<T*>(data);
+    }
+
+    void deallocate(T* data, size_t) noexcept
+    {
+        std::free(data);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&)
+{
+    return false;
+}
+
+// Bump allocator. Individual deallocations are no-ops; everything is given back at once by
+// release() or reset(), so a batch of containers sharing an arena is freed in a handful of calls.
+class Arena
+{
+  public:
+    explicit Arena(size_t iBlockSize = DEFAULT_BLOCK_SIZE) : blockSize(iBlockSize)
+    {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    Arena(Arena&& other) noexcept
+        : blockSize(other.blockSize), head(other.head), cursor(other.cursor), limit(other.limit),
+          used(other.used)
+    {
+        other.head = nullptr;
+        other.cursor = nullptr;
+        other.limit = nullptr;
+        other.used = 0;
+    }
+
+    Arena& operator=(Arena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            blockSize = other.blockSize;
+            head = other.head;
+            cursor = other.cursor;
+            limit = other.limit;
+            used = other.used;
+            other.head = nullptr;
+            other.cursor = nullptr;
+            other.limit = nullptr;
+            other.used = 0;
+        }
+        return *this;
+    }
+
+    ~Arena()
+    {
+        release();
+    }
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        char* data = align(cursor, alignment);
+        if (data == nullptr || data + bytes > limit)
+        {
+            data = allocateFromNewBlock(bytes, alignment);
+        }
+        else
+        {
+            cursor = data + bytes;
+        }
+        used += bytes;
+        return data;
+    }
+
+    // Frees every block. All memory handed out by the arena becomes invalid.
+    void release()
+    {
+        while (head != nullptr)
+        {
+            Block* next = head->next;
+            std::free(head);
+            head = next;
+        }
+        cursor = nullptr;
+        limit = nullptr;
+        used = 0;
+    }
+
+    // Like release(), but keeps the current block so that the next batch reuses it.
+    void reset()
+    {
+        if (head == nullptr)
+        {
+            return;
+        }
+
+        Block* current = head;
+        head = head->next;
+        release();
+
+        current->next = nullptr;
+        head = current;
+        cursor = current->data();
+        limit = cursor + current->size;
+    }
+
+    size_t bytesUsed() const
+    {
+        return used;
+    }
+
+  private:
+    struct Block
+    {
+        Block* next;
+        size_t size;
+
+        char* data()
+        {
+            return reinterpret_cast<char*>(this) + sizeof(Block);
+        }
+    };
+
+    constexpr static size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    size_t blockSize;
+    Block* head = nullptr;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    size_t used = 0;
+
+    static char* align(char* data, size_t alignment)
+    {
+        if (data == nullptr)
+        {
+            return nullptr;
+        }
+        uintptr_t address = reinterpret_cast<uintptr_t>(data);
+        return data + ((alignment - address % alignment) % alignment);
+    }
+
+    char* allocateFromNewBlock(size_t bytes, size_t alignment)
+    {
+        size_t size = bytes + alignment;
+        // Oversized requests get a dedicated block so the current one keeps being bumped.
+        bool dedicated = size > blockSize / 2 && head != nullptr;
+        size_t allocationSize = dedicated || size > blockSize ? size : blockSize;
+
+        void* memory = std::malloc(sizeof(Block) + allocationSize);
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        Block* block = static_cast<Block*>(memory);
+        block->size = allocationSize;
+        char* data = align(block->data(), alignment);
+
+        if (dedicated)
+        {
+            block->next = head->next;
+            head->next = block;
+            return data;
+        }
+
+        block->next = head;
+        head = block;
+        cursor = data + bytes;
+        limit = block->data() + allocationSize;
+        return data;
+    }
+};
+
+// Allocates from an Arena. The allocator does not propagate on assignment or swap: an Array keeps
+// the arena it was built with, so releasing the arena of an array it was assigned from does not
+// invalidate it.
+template <typename T>
+class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& iArena) noexcept : arena(&iArena)
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(&other.getArena())
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept
+    {
+    }
+
+    Arena& getArena() const
+    {
+        return *arena;
+    }
+
+  private:
+    Arena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return &lhs.getArena() == &rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// Detects the optional reallocate(data, oldCount, newCount) extension used by Array for trivially
+// relocatable element types.
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type
+{
+};
+
+template <typename Allocator>
+struct HasReallocate<Allocator, decltype(std::declval<Allocator&>().reallocate(
+                                             std::declval<typename Allocator::value_type*>(),
+                                             size_t{}, size_t{}),
+                                         void())> : std::true_type
+{
+};
+} // namespace ds
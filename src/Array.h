@@ -1,12 +1,59 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Allocator.h"
 
 namespace ds
 {
 
+// Types for which moving an object to a new address and abandoning the old one is equivalent to
+// copying its bytes. Array grows such buffers with memcpy/realloc instead of per-element moves.
+// Specialize to std::true_type to opt a type in.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T, size_t N>
+class SmallArray;
+
 template <typename T>
+class MappedArray;
+
+// Growth policies return the capacity to grow to from capacity, which is 0 for the first
+// allocation. Any callable with that signature can be used, e.g. std::function<size_t(size_t)>.
+template <size_t Numerator, size_t Denominator, size_t Initial = 32>
+struct GeometricGrowth
+{
+    size_t operator()(size_t capacity) const
+    {
+        return capacity == 0 ? Initial : capacity / Denominator * Numerator +
+                                             capacity % Denominator * Numerator / Denominator;
+    }
+};
+
+using DoublingGrowth = GeometricGrowth<2, 1>;
+using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+
+// Linear growth: no more than Increment elements of slack, at the price of more reallocations.
+template <size_t Increment>
+struct FixedGrowth
+{
+    size_t operator()(size_t capacity) const
+    {
+        return capacity + Increment;
+    }
+};
+
+template <typename T, typename Allocator = HeapAllocator<T>, typename GrowthPolicy = DoublingGrowth>
 class Array
 {
   public:
@@ -15,57 +62,85 @@ class Array
 
     Array() = default;
 
-    Array(const Array<T>& other)
-        : array(std::make_unique<T[]>(other.currentCapacity)), count(other.count),
+    explicit Array(const Allocator& iAllocator) : allocator(iAllocator)
+    {
+    }
+
+    Array(const Allocator& iAllocator, GrowthPolicy iGrowthPolicy)
+        : allocator(iAllocator), growthPolicy(std::move(iGrowthPolicy))
+    {
+    }
+
+    Array(const Array<T, Allocator, GrowthPolicy>& other)
+        : Array(other, AllocatorTraits::select_on_container_copy_construction(other.allocator))
+    {
+    }
+
+    // Copies other into memory obtained from iAllocator.
+    Array(const Array<T, Allocator, GrowthPolicy>& other, const Allocator& iAllocator)
+        : allocator(iAllocator), growthPolicy(other.growthPolicy), count(0),
           currentCapacity(other.currentCapacity)
     {
-        for (size_t i = 0; i < other.size(); i++)
-        {
-            array[i] = other[i];
-        }
+        array = allocate(currentCapacity);
+        copyConstruct(other, std::is_trivially_copyable<T>{});
     }
 
-    Array(Array<T>&& other) noexcept
-        : array(std::move(other.array)), count(other.count), currentCapacity(other.currentCapacity)
+    Array(Array<T, Allocator, GrowthPolicy>&& other) noexcept
+        : allocator(std::move(other.allocator)), growthPolicy(std::move(other.growthPolicy)),
+          array(other.array), count(other.count), currentCapacity(other.currentCapacity)
     {
+        other.array = nullptr;
         other.count = 0;
         other.currentCapacity = 0;
     }
 
-    Array<T>& operator=(const Array<T>& other)
+    // Assignments and swap only hand over the allocator when std::allocator_traits says it
+    // propagates; otherwise this array keeps allocating from its own allocator.
+    Array<T, Allocator, GrowthPolicy>& operator=(const Array<T, Allocator, GrowthPolicy>& other)
     {
         if (this != &other)
         {
-            array = std::make_unique<T[]>(other.currentCapacity);
-            count = other.count;
-            currentCapacity = other.currentCapacity;
-            for (size_t i = 0; i < other.size(); i++)
+            if (PropagateOnCopy::value && allocator != other.allocator)
             {
-                array[i] = other[i];
+                // The current buffer can only be given back to the allocator that is replaced.
+                destroyAll();
+                deallocate(array, currentCapacity);
+                array = nullptr;
+                count = 0;
+                currentCapacity = 0;
             }
+            assignAllocator(other.allocator, PropagateOnCopy{});
+            growthPolicy = other.growthPolicy;
+            copyAssign(other, std::is_trivially_copyable<T>{});
         }
         return *this;
     }
 
-    Array<T>& operator=(Array<T>&& other) noexcept
+    // When the allocator does not propagate and the two allocators differ, the elements are moved
+    // one by one into memory from this array's allocator, which may throw.
+    Array<T, Allocator, GrowthPolicy>&
+    operator=(Array<T, Allocator, GrowthPolicy>&& other) noexcept(PropagateOnMove::value)
     {
         if (this != &other)
         {
-            array = std::move(other.array);
-            count = other.count;
-            currentCapacity = other.currentCapacity;
-            other.count = 0;
-            other.currentCapacity = 0;
+            moveAssign(other, PropagateOnMove{});
         }
         return *this;
     }
 
-    ~Array() = default;
+    ~Array()
+    {
+        destroyAll();
+        deallocate(array, currentCapacity);
+    }
 
-    void swap(Array<T>& other) noexcept
+    // Unless the allocator propagates on swap, both arrays must use equal allocators.
+    void swap(Array<T, Allocator, GrowthPolicy>& other) noexcept
     {
         using std::swap;
 
+        swapAllocator(other, PropagateOnSwap{});
+        swap(growthPolicy, other.growthPolicy);
         swap(array, other.array);
         swap(count, other.count);
         swap(currentCapacity, other.currentCapacity);
@@ -85,6 +160,11 @@ class Array
         return array[i];
     }
 
+    T* data() const
+    {
+        return array;
+    }
+
     bool isEmpty() const
     {
         return count == 0;
@@ -106,48 +186,65 @@ class Array
         {
             return;
         }
-        auto newArray = std::make_unique<T[]>(newCapacity);
-        for (size_t i = 0; i < count; i++)
-        {
-            newArray[i] = std::move(array[i]);
-        }
-        array = std::move(newArray);
-        currentCapacity = newCapacity;
+        reallocate(newCapacity, IsTriviallyRelocatable<T>{});
     }
 
-    void resize(size_t newSize)
+    // Releases unused capacity. Trivially relocatable elements are shrunk in place by realloc when
+    // the allocator supports it.
+    void shrinkToFit()
     {
-        if (newSize <= currentCapacity)
+        if (count == currentCapacity)
         {
-            count = newSize;
             return;
         }
-
-        if (newSize > currentCapacity)
+        if (count == 0)
         {
-            reserve(newSize);
+            deallocate(array, currentCapacity);
+            array = nullptr;
+            currentCapacity = 0;
+            return;
         }
+        reallocate(count, IsTriviallyRelocatable<T>{});
+    }
 
-        for (size_t i = count; i < newSize; ++i)
+    void resize(size_t newSize)
+    {
+        if (newSize < count)
         {
-            array[i] = T{};
+            destroyRange(newSize, count);
+            count = newSize;
+            return;
         }
 
-        count = newSize;
+        reserve(newSize);
+        valueConstruct(newSize, std::is_trivial<T>{});
     }
 
     void clear()
     {
+        destroyAll();
         count = 0;
     }
 
     void pushBack(const T& data)
+    {
+        emplaceBack(data);
+    }
+
+    void pushBack(T&& data)
+    {
+        emplaceBack(std::move(data));
+    }
+
+    template <typename... Args>
+    T& emplaceBack(Args&&... args)
     {
         if (count == currentCapacity)
         {
-            reserve(currentCapacity == 0 ? DEFAULT_SIZE : currentCapacity * 2);
+            return growAndEmplaceBack(IsTriviallyRelocatable<T>{}, std::forward<Args>(args)...);
         }
-        array[count++] = data;
+        new (array + count) T(std::forward<Args>(args)...);
+        return array[count++];
     }
 
     T popBack()
@@ -157,69 +254,626 @@ class Array
             throw std::runtime_error("Method popBack() called on an empty array");
         }
 
-        T data = std::move(array[--count]);
+        T data = std::move(array[count - 1]);
+        array[--count].~T();
         return data;
     }
 
+    // Range operations size the buffer once up front. The ranges must not refer to this array.
+    template <typename InputIt>
+    void append(InputIt first, InputIt last)
+    {
+        insertRange(count, first, last,
+                    typename std::iterator_traits<InputIt>::iterator_category{});
+    }
+
+    template <typename InputIt>
+    Iterator insert(Iterator pos, InputIt first, InputIt last)
+    {
+        size_t index = pos.data - array;
+        insertRange(index, first, last,
+                    typename std::iterator_traits<InputIt>::iterator_category{});
+        return Iterator(array + index);
+    }
+
+    Iterator erase(Iterator first, Iterator last)
+    {
+        size_t index = first.data - array;
+        size_t n = last.data - first.data;
+        if (n > 0)
+        {
+            eraseRange(index, n, IsTriviallyRelocatable<T>{});
+        }
+        return Iterator(array + index);
+    }
+
+    void assign(size_t n, const T& value)
+    {
+        if (n > currentCapacity)
+        {
+            T* newArray = allocate(n);
+            try
+            {
+                std::uninitialized_fill_n(newArray, n, value);
+            }
+            catch (...)
+            {
+                deallocate(newArray, n);
+                throw;
+            }
+            destroyAll();
+            deallocate(array, currentCapacity);
+            array = newArray;
+            count = n;
+            currentCapacity = n;
+            return;
+        }
+
+        size_t assigned = n < count ? n : count;
+        std::fill_n(array, assigned, value);
+        if (n < count)
+        {
+            destroyRange(n, count);
+        }
+        else
+        {
+            std::uninitialized_fill_n(array + count, n - count, value);
+        }
+        count = n;
+    }
+
     Iterator begin()
     {
-        return Iterator(array.get());
+        return Iterator(array);
     }
 
     Iterator end()
     {
-        return Iterator(array.get() + count);
+        return Iterator(array + count);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(array);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(array + count);
     }
 
     Iterator rbegin()
     {
-        return Iterator(array.get() + count - 1);
+        return Iterator(array + count - 1);
     }
 
     Iterator rend()
     {
-        return Iterator(array.get() - 1);
+        return Iterator(array - 1);
     }
 
     ConstIterator cbegin() const
     {
-        return ConstIterator(array.get());
+        return ConstIterator(array);
     }
 
     ConstIterator cend() const
     {
-        return ConstIterator(array.get() + count);
+        return ConstIterator(array + count);
     }
 
     ConstIterator crbegin() const
     {
-        return ConstIterator(array.get() + count - 1);
+        return ConstIterator(array + count - 1);
     }
 
     ConstIterator crend() const
     {
-        return ConstIterator(array.get() - 1);
+        return ConstIterator(array - 1);
+    }
+
+    Allocator getAllocator() const
+    {
+        return allocator;
     }
 
   private:
-    constexpr static size_t DEFAULT_SIZE = 32;
-    std::unique_ptr<T[]> array;
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    using PropagateOnCopy = typename AllocatorTraits::propagate_on_container_copy_assignment;
+    using PropagateOnMove = typename AllocatorTraits::propagate_on_container_move_assignment;
+    using PropagateOnSwap = typename AllocatorTraits::propagate_on_container_swap;
+
+    Allocator allocator;
+    GrowthPolicy growthPolicy;
+    T* array = nullptr;
     size_t count = 0;
     size_t currentCapacity = 0;
+
+    T* allocate(size_t n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+        return AllocatorTraits::allocate(allocator, n);
+    }
+
+    void deallocate(T* data, size_t n)
+    {
+        if (data != nullptr)
+        {
+            AllocatorTraits::deallocate(allocator, data, n);
+        }
+    }
+
+    size_t nextCapacity() const
+    {
+        size_t next = growthPolicy(currentCapacity);
+        return next > currentCapacity ? next : currentCapacity + 1;
+    }
+
+    void copyConstruct(const Array<T, Allocator, GrowthPolicy>& other, std::true_type)
+    {
+        if (other.count > 0)
+        {
+            std::memcpy(static_cast<void*>(array), other.array, other.count * sizeof(T));
+        }
+        count = other.count;
+    }
+
+    void copyConstruct(const Array<T, Allocator, GrowthPolicy>& other, std::false_type)
+    {
+        try
+        {
+            for (; count < other.count; ++count)
+            {
+                new (array + count) T(other.array[count]);
+            }
+        }
+        catch (...)
+        {
+            destroyAll();
+            deallocate(array, currentCapacity);
+            throw;
+        }
+    }
+
+    void copyAssign(const Array<T, Allocator, GrowthPolicy>& other, std::true_type)
+    {
+        if (other.count > currentCapacity)
+        {
+            Array<T, Allocator, GrowthPolicy> copy(other, allocator);
+            swapBuffers(copy);
+            return;
+        }
+        if (other.count > 0)
+        {
+            std::memcpy(static_cast<void*>(array), other.array, other.count * sizeof(T));
+        }
+        count = other.count;
+    }
+
+    void copyAssign(const Array<T, Allocator, GrowthPolicy>& other, std::false_type)
+    {
+        Array<T, Allocator, GrowthPolicy> copy(other, allocator);
+        swapBuffers(copy);
+    }
+
+    void moveAssign(Array<T, Allocator, GrowthPolicy>& other, std::true_type) noexcept
+    {
+        destroyAll();
+        deallocate(array, currentCapacity);
+        allocator = std::move(other.allocator);
+        takeBuffer(other);
+    }
+
+    void moveAssign(Array<T, Allocator, GrowthPolicy>& other, std::false_type)
+    {
+        if (allocator == other.allocator)
+        {
+            destroyAll();
+            deallocate(array, currentCapacity);
+            takeBuffer(other);
+            return;
+        }
+
+        clear();
+        reserve(other.count);
+        moveConstruct(other.array, other.array + other.count, array);
+        count = other.count;
+        growthPolicy = std::move(other.growthPolicy);
+        other.clear();
+    }
+
+    // Takes the buffer of other, whose allocator must be able to free it from this array.
+    void takeBuffer(Array<T, Allocator, GrowthPolicy>& other) noexcept
+    {
+        growthPolicy = std::move(other.growthPolicy);
+        array = other.array;
+        count = other.count;
+        currentCapacity = other.currentCapacity;
+        other.array = nullptr;
+        other.count = 0;
+        other.currentCapacity = 0;
+    }
+
+    // Exchanges contents with an array using an equal allocator, keeping the allocators in place.
+    void swapBuffers(Array<T, Allocator, GrowthPolicy>& other) noexcept
+    {
+        using std::swap;
+
+        swap(growthPolicy, other.growthPolicy);
+        swap(array, other.array);
+        swap(count, other.count);
+        swap(currentCapacity, other.currentCapacity);
+    }
+
+    void assignAllocator(const Allocator& other, std::true_type)
+    {
+        allocator = other;
+    }
+
+    void assignAllocator(const Allocator&, std::false_type)
+    {
+    }
+
+    void swapAllocator(Array<T, Allocator, GrowthPolicy>& other, std::true_type) noexcept
+    {
+        using std::swap;
+
+        swap(allocator, other.allocator);
+    }
+
+    void swapAllocator(Array<T, Allocator, GrowthPolicy>&, std::false_type) noexcept
+    {
+    }
+
+    void valueConstruct(size_t newSize, std::true_type)
+    {
+        std::memset(static_cast<void*>(array + count), 0, (newSize - count) * sizeof(T));
+        count = newSize;
+    }
+
+    void valueConstruct(size_t newSize, std::false_type)
+    {
+        for (; count < newSize; ++count)
+        {
+            new (array + count) T();
+        }
+    }
+
+    void reallocate(size_t newCapacity, std::true_type)
+    {
+        if (array == nullptr)
+        {
+            array = allocate(newCapacity);
+        }
+        else
+        {
+            array = reallocateBuffer(newCapacity, HasReallocate<Allocator>{});
+        }
+        currentCapacity = newCapacity;
+    }
+
+    // HeapAllocator uses realloc, which either extends the block in place or moves it with a bulk
+    // copy; glibc serves large blocks with mmap and moves them with mremap without copying.
+    T* reallocateBuffer(size_t newCapacity, std::true_type)
+    {
+        return allocator.reallocate(array, currentCapacity, newCapacity);
+    }
+
+    T* reallocateBuffer(size_t newCapacity, std::false_type)
+    {
+        T* newArray = allocate(newCapacity);
+        if (count > 0)
+        {
+            std::memcpy(static_cast<void*>(newArray), static_cast<void*>(array), count * sizeof(T));
+        }
+        deallocate(array, currentCapacity);
+        return newArray;
+    }
+
+    void reallocate(size_t newCapacity, std::false_type)
+    {
+        T* newArray = allocate(newCapacity);
+        try
+        {
+            relocate(newArray);
+        }
+        catch (...)
+        {
+            deallocate(newArray, newCapacity);
+            throw;
+        }
+        array = newArray;
+        currentCapacity = newCapacity;
+    }
+
+    void destroyRange(size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            array[i].~T();
+        }
+    }
+
+    void destroyAll()
+    {
+        destroyRange(0, count);
+    }
+
+    // Moves the live elements into newArray and releases the current buffer. On failure the
+    // current buffer is left untouched and newArray is still owned by the caller.
+    void relocate(T* newArray)
+    {
+        size_t i = 0;
+        try
+        {
+            for (; i < count; ++i)
+            {
+                new (newArray + i) T(std::move_if_noexcept(array[i]));
+            }
+        }
+        catch (...)
+        {
+            for (size_t j = 0; j < i; ++j)
+            {
+                newArray[j].~T();
+            }
+            throw;
+        }
+        destroyAll();
+        deallocate(array, currentCapacity);
+    }
+
+    size_t capacityFor(size_t required) const
+    {
+        size_t next = nextCapacity();
+        return required > next ? required : next;
+    }
+
+    template <typename InputIt>
+    void insertRange(size_t index, InputIt first, InputIt last, std::input_iterator_tag)
+    {
+        Array<T, Allocator, GrowthPolicy> buffer(allocator, growthPolicy);
+        for (; first != last; ++first)
+        {
+            buffer.emplaceBack(*first);
+        }
+        insertRange(index, std::make_move_iterator(buffer.array),
+                    std::make_move_iterator(buffer.array + buffer.count),
+                    std::forward_iterator_tag{});
+    }
+
+    template <typename ForwardIt>
+    void insertRange(size_t index, ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+    {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        if (n == 0)
+        {
+            return;
+        }
+        if (count + n > currentCapacity)
+        {
+            growAndInsert(index, n, first, last, IsTriviallyRelocatable<T>{});
+        }
+        else if (index == count)
+        {
+            std::uninitialized_copy(first, last, array + count);
+        }
+        else
+        {
+            insertInPlace(index, n, first, last, IsTriviallyRelocatable<T>{});
+        }
+        count += n;
+    }
+
+    // The inserted elements are constructed in the new buffer first, then the existing ones are
+    // relocated around them.
+    template <typename ForwardIt>
+    void growAndInsert(size_t index, size_t n, ForwardIt first, ForwardIt last, std::true_type)
+    {
+        size_t newCapacity = capacityFor(count + n);
+        T* newArray = allocate(newCapacity);
+        try
+        {
+            std::uninitialized_copy(first, last, newArray + index);
+        }
+        catch (...)
+        {
+            deallocate(newArray, newCapacity);
+            throw;
+        }
+        if (array != nullptr)
+        {
+            std::memcpy(static_cast<void*>(newArray), static_cast<void*>(array), index * sizeof(T));
+            std::memcpy(static_cast<void*>(newArray + index + n),
+                        static_cast<void*>(array + index), (count - index) * sizeof(T));
+        }
+        deallocate(array, currentCapacity);
+        array = newArray;
+        currentCapacity = newCapacity;
+    }
+
+    template <typename ForwardIt>
+    void growAndInsert(size_t index, size_t n, ForwardIt first, ForwardIt last, std::false_type)
+    {
+        size_t newCapacity = capacityFor(count + n);
+        T* newArray = allocate(newCapacity);
+        size_t constructed = 0;
+        try
+        {
+            std::uninitialized_copy(first, last, newArray + index);
+            constructed = n;
+            moveConstruct(array, array + index, newArray);
+            constructed += index;
+            moveConstruct(array + index, array + count, newArray + index + n);
+        }
+        catch (...)
+        {
+            if (constructed > 0)
+            {
+                destroyRangeOf(newArray + index, n);
+            }
+            if (constructed > n)
+            {
+                destroyRangeOf(newArray, index);
+            }
+            deallocate(newArray, newCapacity);
+            throw;
+        }
+        destroyAll();
+        deallocate(array, currentCapacity);
+        array = newArray;
+        currentCapacity = newCapacity;
+    }
+
+    template <typename ForwardIt>
+    void insertInPlace(size_t index, size_t n, ForwardIt first, ForwardIt last, std::true_type)
+    {
+        T* gap = array + index;
+        std::memmove(static_cast<void*>(gap + n), static_cast<void*>(gap),
+                     (count - index) * sizeof(T));
+        try
+        {
+            std::uninitialized_copy(first, last, gap);
+        }
+        catch (...)
+        {
+            std::memmove(static_cast<void*>(gap), static_cast<void*>(gap + n),
+                         (count - index) * sizeof(T));
+            throw;
+        }
+    }
+
+    // Constructs the new elements at the end and rotates them into place.
+    template <typename ForwardIt>
+    void insertInPlace(size_t index, size_t n, ForwardIt first, ForwardIt last, std::false_type)
+    {
+        std::uninitialized_copy(first, last, array + count);
+        try
+        {
+            std::rotate(array + index, array + count, array + count + n);
+        }
+        catch (...)
+        {
+            destroyRangeOf(array + count, n);
+            throw;
+        }
+    }
+
+    void eraseRange(size_t index, size_t n, std::true_type)
+    {
+        destroyRange(index, index + n);
+        std::memmove(static_cast<void*>(array + index), static_cast<void*>(array + index + n),
+                     (count - index - n) * sizeof(T));
+        count -= n;
+    }
+
+    void eraseRange(size_t index, size_t n, std::false_type)
+    {
+        std::move(array + index + n, array + count, array + index);
+        destroyRange(count - n, count);
+        count -= n;
+    }
+
+    // Move-constructs [first, last) into dest. On failure the elements already constructed in dest
+    // are destroyed.
+    static void moveConstruct(T* first, T* last, T* dest)
+    {
+        T* current = dest;
+        try
+        {
+            for (; first != last; ++first, ++current)
+            {
+                new (current) T(std::move_if_noexcept(*first));
+            }
+        }
+        catch (...)
+        {
+            destroyRangeOf(dest, current - dest);
+            throw;
+        }
+    }
+
+    static void destroyRangeOf(T* data, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            data[i].~T();
+        }
+    }
+
+    // The new element is constructed before the old ones are moved so that arguments referring to
+    // an element of this array stay valid.
+    template <typename... Args>
+    T& growAndEmplaceBack(std::true_type, Args&&... args)
+    {
+        T data(std::forward<Args>(args)...);
+        reallocate(nextCapacity(), std::true_type{});
+        new (array + count) T(std::move(data));
+        return array[count++];
+    }
+
+    template <typename... Args>
+    T& growAndEmplaceBack(std::false_type, Args&&... args)
+    {
+        size_t newCapacity = nextCapacity();
+        T* newArray = allocate(newCapacity);
+        try
+        {
+            new (newArray + count) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(newArray, newCapacity);
+            throw;
+        }
+        try
+        {
+            relocate(newArray);
+        }
+        catch (...)
+        {
+            newArray[count].~T();
+            deallocate(newArray, newCapacity);
+            throw;
+        }
+        array = newArray;
+        currentCapacity = newCapacity;
+        return array[count++];
+    }
 };
 
-template <typename T>
-class Array<T>::Iterator
+template <typename T, typename Allocator, typename GrowthPolicy>
+class Array<T, Allocator, GrowthPolicy>::Iterator
 {
   public:
-    T& operator*() const
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Iterator() : data(nullptr)
+    {
+    }
+
+    reference operator*() const
     {
         return *data;
     }
-    T* operator->() const
+    pointer operator->() const
     {
         return data;
     }
+    reference operator[](difference_type n) const
+    {
+        return data[n];
+    }
     bool operator==(const Iterator& other) const
     {
         return data == other.data;
@@ -228,6 +882,22 @@ class Array<T>::Iterator
     {
         return data != other.data;
     }
+    bool operator<(const Iterator& other) const
+    {
+        return data < other.data;
+    }
+    bool operator>(const Iterator& other) const
+    {
+        return data > other.data;
+    }
+    bool operator<=(const Iterator& other) const
+    {
+        return data <= other.data;
+    }
+    bool operator>=(const Iterator& other) const
+    {
+        return data >= other.data;
+    }
     Iterator& operator++()
     {
         data++;
@@ -250,6 +920,32 @@ class Array<T>::Iterator
         --(*this);
         return tmp;
     }
+    Iterator& operator+=(difference_type n)
+    {
+        data += n;
+        return *this;
+    }
+    Iterator& operator-=(difference_type n)
+    {
+        data -= n;
+        return *this;
+    }
+    Iterator operator+(difference_type n) const
+    {
+        return Iterator(data + n);
+    }
+    Iterator operator-(difference_type n) const
+    {
+        return Iterator(data - n);
+    }
+    difference_type operator-(const Iterator& other) const
+    {
+        return data - other.data;
+    }
+    friend Iterator operator+(difference_type n, const Iterator& it)
+    {
+        return it + n;
+    }
 
   private:
     explicit Iterator(T* iData) : data(iData)
@@ -259,20 +955,46 @@ class Array<T>::Iterator
     T* data;
 
     friend class Array;
+    friend class ConstIterator;
+    template <typename, size_t>
+    friend class SmallArray;
+    template <typename>
+    friend class MappedArray;
 };
 
-template <typename T>
-class Array<T>::ConstIterator
+template <typename T, typename Allocator, typename GrowthPolicy>
+class Array<T, Allocator, GrowthPolicy>::ConstIterator
 {
   public:
-    const T& operator*() const
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    ConstIterator() : data(nullptr)
+    {
+    }
+
+    ConstIterator(const Iterator& other) : data(other.data)
+    {
+    }
+
+    reference operator*() const
     {
         return *data;
     }
-    const T* operator->() const
+    pointer operator->() const
     {
         return data;
     }
+    reference operator[](difference_type n) const
+    {
+        return data[n];
+    }
     bool operator==(const ConstIterator& other) const
     {
         return data == other.data;
@@ -281,6 +1003,22 @@ class Array<T>::ConstIterator
     {
         return data != other.data;
     }
+    bool operator<(const ConstIterator& other) const
+    {
+        return data < other.data;
+    }
+    bool operator>(const ConstIterator& other) const
+    {
+        return data > other.data;
+    }
+    bool operator<=(const ConstIterator& other) const
+    {
+        return data <= other.data;
+    }
+    bool operator>=(const ConstIterator& other) const
+    {
+        return data >= other.data;
+    }
     ConstIterator& operator++()
     {
         data++;
@@ -303,14 +1041,44 @@ class Array<T>::ConstIterator
         --(*this);
         return tmp;
     }
+    ConstIterator& operator+=(difference_type n)
+    {
+        data += n;
+        return *this;
+    }
+    ConstIterator& operator-=(difference_type n)
+    {
+        data -= n;
+        return *this;
+    }
+    ConstIterator operator+(difference_type n) const
+    {
+        return ConstIterator(data + n);
+    }
+    ConstIterator operator-(difference_type n) const
+    {
+        return ConstIterator(data - n);
+    }
+    difference_type operator-(const ConstIterator& other) const
+    {
+        return data - other.data;
+    }
+    friend ConstIterator operator+(difference_type n, const ConstIterator& it)
+    {
+        return it + n;
+    }
 
   private:
-    explicit ConstIterator(T* iData) : data(iData)
+    explicit ConstIterator(const T* iData) : data(iData)
     {
     }
 
-    T* data;
+    const T* data;
 
     friend class Array;
+    template <typename, size_t>
+    friend class SmallArray;
+    template <typename>
+    friend class MappedArray;
 };
 } // namespace ds
\ No newline at end of file
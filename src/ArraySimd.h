@@ -0,0 +1,788 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+#define DS_SIMD_X86 1
+#include <immintrin.h>
+#define DS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DS_SIMD_X86 0
+#endif
+
+namespace ds
+{
+
+// Accumulator type of sum(): 64-bit integers for integral types, at least double otherwise.
+template <typename T>
+using SumType = typename std::conditional<
+    std::is_floating_point<T>::value, typename std::common_type<T, double>::type,
+    typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>::type;
+
+namespace simd
+{
+
+template <typename T>
+struct ScalarKernels
+{
+    static size_t find(const T* data, size_t n, T value)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (data[i] == value)
+            {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    static size_t count(const T* data, size_t n, T value)
+    {
+        size_t result = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            result += data[i] == value;
+        }
+        return result;
+    }
+
+    static SumType<T> sum(const T* data, size_t n)
+    {
+        SumType<T> result = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            result += data[i];
+        }
+        return result;
+    }
+
+    // Folds data into min and max, which the caller seeds.
+    static void minMax(const T* data, size_t n, T& min, T& max)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            min = data[i] < min ? data[i] : min;
+            max = data[i] > max ? data[i] : max;
+        }
+    }
+
+    // Writes the elements greater than threshold to out, which must have room for n elements.
+    static size_t filterGreater(const T* data, size_t n, T threshold, T* out)
+    {
+        size_t written = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[written] = data[i];
+            written += data[i] > threshold;
+        }
+        return written;
+    }
+};
+
+#if DS_SIMD_X86
+
+inline bool hasAvx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+template <typename T>
+inline size_t compress(const T* data, int mask, size_t lanes, T* out)
+{
+    size_t written = 0;
+    for (size_t j = 0; j < lanes; ++j)
+    {
+        out[written] = data[j];
+        written += (mask >> j) & 1;
+    }
+    return written;
+}
+
+namespace sse2
+{
+
+inline size_t find(const int32_t* data, size_t n, int32_t value)
+{
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, needle)));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScalarKernels<int32_t>::find(data + i, n - i, value);
+}
+
+inline size_t count(const int32_t* data, size_t n, int32_t value)
+{
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        result += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, needle))));
+    }
+    return result + ScalarKernels<int32_t>::count(data + i, n - i, value);
+}
+
+inline int64_t sum(const int32_t* data, size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+    }
+    alignas(16) int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + ScalarKernels<int32_t>::sum(data + i, n - i);
+}
+
+inline void minMax(const int32_t* data, size_t n, int32_t& min, int32_t& max)
+{
+    size_t i = 0;
+    if (n >= 4)
+    {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i hi = lo;
+        for (i = 4; i + 4 <= n; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i lt = _mm_cmplt_epi32(v, lo);
+            __m128i gt = _mm_cmpgt_epi32(v, hi);
+            lo = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, lo));
+            hi = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, hi));
+        }
+        alignas(16) int32_t lows[4];
+        alignas(16) int32_t highs[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lows), lo);
+        _mm_store_si128(reinterpret_cast<__m128i*>(highs), hi);
+        ScalarKernels<int32_t>::minMax(lows, 4, min, max);
+        ScalarKernels<int32_t>::minMax(highs, 4, min, max);
+    }
+    ScalarKernels<int32_t>::minMax(data + i, n - i, min, max);
+}
+
+inline size_t filterGreater(const int32_t* data, size_t n, int32_t threshold, int32_t* out)
+{
+    const __m128i bound = _mm_set1_epi32(threshold);
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, bound)));
+        written += compress(data + i, mask, 4, out + written);
+    }
+    return written +
+           ScalarKernels<int32_t>::filterGreater(data + i, n - i, threshold, out + written);
+}
+
+inline size_t find(const float* data, size_t n, float value)
+{
+    const __m128 needle = _mm_set1_ps(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScalarKernels<float>::find(data + i, n - i, value);
+}
+
+inline size_t count(const float* data, size_t n, float value)
+{
+    const __m128 needle = _mm_set1_ps(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        result += __builtin_popcount(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle)));
+    }
+    return result + ScalarKernels<float>::count(data + i, n - i, value);
+}
+
+inline double sum(const float* data, size_t n)
+{
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 v = _mm_loadu_ps(data + i);
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(v));
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + ScalarKernels<float>::sum(data + i, n - i);
+}
+
+inline void minMax(const float* data, size_t n, float& min, float& max)
+{
+    size_t i = 0;
+    if (n >= 4)
+    {
+        __m128 lo = _mm_loadu_ps(data);
+        __m128 hi = lo;
+        for (i = 4; i + 4 <= n; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(data + i);
+            lo = _mm_min_ps(lo, v);
+            hi = _mm_max_ps(hi, v);
+        }
+        alignas(16) float lows[4];
+        alignas(16) float highs[4];
+        _mm_store_ps(lows, lo);
+        _mm_store_ps(highs, hi);
+        ScalarKernels<float>::minMax(lows, 4, min, max);
+        ScalarKernels<float>::minMax(highs, 4, min, max);
+    }
+    ScalarKernels<float>::minMax(data + i, n - i, min, max);
+}
+
+inline size_t filterGreater(const float* data, size_t n, float threshold, float* out)
+{
+    const __m128 bound = _mm_set1_ps(threshold);
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        int mask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(data + i), bound));
+        written += compress(data + i, mask, 4, out + written);
+    }
+    return written + ScalarKernels<float>::filterGreater(data + i, n - i, threshold, out + written);
+}
+
+inline size_t find(const double* data, size_t n, double value)
+{
+    const __m128d needle = _mm_set1_pd(value);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), needle));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScalarKernels<double>::find(data + i, n - i, value);
+}
+
+inline size_t count(const double* data, size_t n, double value)
+{
+    const __m128d needle = _mm_set1_pd(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        result += __builtin_popcount(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), needle)));
+    }
+    return result + ScalarKernels<double>::count(data + i, n - i, value);
+}
+
+inline double sum(const double* data, size_t n)
+{
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        acc = _mm_add_pd(acc, _mm_loadu_pd(data + i));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + ScalarKernels<double>::sum(data + i, n - i);
+}
+
+inline void minMax(const double* data, size_t n, double& min, double& max)
+{
+    size_t i = 0;
+    if (n >= 2)
+    {
+        __m128d lo = _mm_loadu_pd(data);
+        __m128d hi = lo;
+        for (i = 2; i + 2 <= n; i += 2)
+        {
+            __m128d v = _mm_loadu_pd(data + i);
+            lo = _mm_min_pd(lo, v);
+            hi = _mm_max_pd(hi, v);
+        }
+        alignas(16) double lows[2];
+        alignas(16) double highs[2];
+        _mm_store_pd(lows, lo);
+        _mm_store_pd(highs, hi);
+        ScalarKernels<double>::minMax(lows, 2, min, max);
+        ScalarKernels<double>::minMax(highs, 2, min, max);
+    }
+    ScalarKernels<double>::minMax(data + i, n - i, min, max);
+}
+
+inline size_t filterGreater(const double* data, size_t n, double threshold, double* out)
+{
+    const __m128d bound = _mm_set1_pd(threshold);
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        int mask = _mm_movemask_pd(_mm_cmpgt_pd(_mm_loadu_pd(data + i), bound));
+        written += compress(data + i, mask, 2, out + written);
+    }
+    return written +
+           ScalarKernels<double>::filterGreater(data + i, n - i, threshold, out + written);
+}
+} // namespace sse2
+
+namespace avx2
+{
+
+// Permutations that move the selected lanes of a 256-bit vector to its front, indexed by the
+// comparison mask: lanes() for eight 32-bit lanes, pairs() for four 64-bit lanes.
+class CompressTable
+{
+  public:
+    CompressTable()
+    {
+        for (int mask = 0; mask < 256; ++mask)
+        {
+            int k = 0;
+            for (int j = 0; j < 8; ++j)
+            {
+                if ((mask >> j) & 1)
+                {
+                    singles[mask][k++] = j;
+                }
+            }
+            for (; k < 8; ++k)
+            {
+                singles[mask][k] = 0;
+            }
+        }
+        for (int mask = 0; mask < 16; ++mask)
+        {
+            int k = 0;
+            for (int j = 0; j < 4; ++j)
+            {
+                if ((mask >> j) & 1)
+                {
+                    doubles[mask][k++] = 2 * j;
+                    doubles[mask][k++] = 2 * j + 1;
+                }
+            }
+            for (; k < 8; ++k)
+            {
+                doubles[mask][k] = 0;
+            }
+        }
+    }
+
+    DS_TARGET_AVX2 __m256i lanes(int mask) const
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(singles[mask]));
+    }
+
+    DS_TARGET_AVX2 __m256i pairs(int mask) const
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(doubles[mask]));
+    }
+
+  private:
+    alignas(32) int32_t singles[256][8];
+    alignas(32) int32_t doubles[16][8];
+};
+
+inline const CompressTable& compressTable()
+{
+    static const CompressTable table;
+    return table;
+}
+
+DS_TARGET_AVX2 inline size_t find(const int32_t* data, size_t n, int32_t value)
+{
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle)));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScalarKernels<int32_t>::find(data + i, n - i, value);
+}
+
+DS_TARGET_AVX2 inline size_t count(const int32_t* data, size_t n, int32_t value)
+{
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        result += __builtin_popcount(
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle))));
+    }
+    return result + ScalarKernels<int32_t>::count(data + i, n - i, value);
+}
+
+DS_TARGET_AVX2 inline int64_t sum(const int32_t* data, size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(low));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(high));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           ScalarKernels<int32_t>::sum(data + i, n - i);
+}
+
+DS_TARGET_AVX2 inline void minMax(const int32_t* data, size_t n, int32_t& min, int32_t& max)
+{
+    size_t i = 0;
+    if (n >= 8)
+    {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i hi = lo;
+        for (i = 8; i + 8 <= n; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            lo = _mm256_min_epi32(lo, v);
+            hi = _mm256_max_epi32(hi, v);
+        }
+        alignas(32) int32_t lows[8];
+        alignas(32) int32_t highs[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lows), lo);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(highs), hi);
+        ScalarKernels<int32_t>::minMax(lows, 8, min, max);
+        ScalarKernels<int32_t>::minMax(highs, 8, min, max);
+    }
+    ScalarKernels<int32_t>::minMax(data + i, n - i, min, max);
+}
+
+DS_TARGET_AVX2 inline size_t filterGreater(const int32_t* data, size_t n, int32_t threshold,
+                                           int32_t* out)
+{
+    const __m256i bound = _mm256_set1_epi32(threshold);
+    const CompressTable& table = compressTable();
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, bound)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written),
+                            _mm256_permutevar8x32_epi32(v, table.lanes(mask)));
+        written += __builtin_popcount(mask);
+    }
+    return written +
+           ScalarKernels<int32_t>::filterGreater(data + i, n - i, threshold, out + written);
+}
+
+DS_TARGET_AVX2 inline size_t find(const float* data, size_t n, float value)
+{
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScalarKernels<float>::find(data + i, n - i, value);
+}
+
+DS_TARGET_AVX2 inline size_t count(const float* data, size_t n, float value)
+{
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        result += __builtin_popcount(
+            _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ)));
+    }
+    return result + ScalarKernels<float>::count(data + i, n - i, value);
+}
+
+DS_TARGET_AVX2 inline double sum(const float* data, size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(data + i)));
+        acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(data + i + 4)));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + ScalarKernels<float>::sum(data + i, n - i);
+}
+
+DS_TARGET_AVX2 inline void minMax(const float* data, size_t n, float& min, float& max)
+{
+    size_t i = 0;
+    if (n >= 8)
+    {
+        __m256 lo = _mm256_loadu_ps(data);
+        __m256 hi = lo;
+        for (i = 8; i + 8 <= n; i += 8)
+        {
+            __m256 v = _mm256_loadu_ps(data + i);
+            lo = _mm256_min_ps(lo, v);
+            hi = _mm256_max_ps(hi, v);
+        }
+        alignas(32) float lows[8];
+        alignas(32) float highs[8];
+        _mm256_store_ps(lows, lo);
+        _mm256_store_ps(highs, hi);
+        ScalarKernels<float>::minMax(lows, 8, min, max);
+        ScalarKernels<float>::minMax(highs, 8, min, max);
+    }
+    ScalarKernels<float>::minMax(data + i, n - i, min, max);
+}
+
+DS_TARGET_AVX2 inline size_t filterGreater(const float* data, size_t n, float threshold,
+                                           float* out)
+{
+    const __m256 bound = _mm256_set1_ps(threshold);
+    const CompressTable& table = compressTable();
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(data + i);
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(v, bound, _CMP_GT_OQ));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written),
+                            _mm256_permutevar8x32_epi32(_mm256_castps_si256(v), table.lanes(mask)));
+        written += __builtin_popcount(mask);
+    }
+    return written + ScalarKernels<float>::filterGreater(data + i, n - i, threshold, out + written);
+}
+
+DS_TARGET_AVX2 inline size_t find(const double* data, size_t n, double value)
+{
+    const __m256d needle = _mm256_set1_pd(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + ScalarKernels<double>::find(data + i, n - i, value);
+}
+
+DS_TARGET_AVX2 inline size_t count(const double* data, size_t n, double value)
+{
+    const __m256d needle = _mm256_set1_pd(value);
+    size_t result = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        result += __builtin_popcount(
+            _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ)));
+    }
+    return result + ScalarKernels<double>::count(data + i, n - i, value);
+}
+
+DS_TARGET_AVX2 inline double sum(const double* data, size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(data + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + ScalarKernels<double>::sum(data + i, n - i);
+}
+
+DS_TARGET_AVX2 inline void minMax(const double* data, size_t n, double& min, double& max)
+{
+    size_t i = 0;
+    if (n >= 4)
+    {
+        __m256d lo = _mm256_loadu_pd(data);
+        __m256d hi = lo;
+        for (i = 4; i + 4 <= n; i += 4)
+        {
+            __m256d v = _mm256_loadu_pd(data + i);
+            lo = _mm256_min_pd(lo, v);
+            hi = _mm256_max_pd(hi, v);
+        }
+        alignas(32) double lows[4];
+        alignas(32) double highs[4];
+        _mm256_store_pd(lows, lo);
+        _mm256_store_pd(highs, hi);
+        ScalarKernels<double>::minMax(lows, 4, min, max);
+        ScalarKernels<double>::minMax(highs, 4, min, max);
+    }
+    ScalarKernels<double>::minMax(data + i, n - i, min, max);
+}
+
+DS_TARGET_AVX2 inline size_t filterGreater(const double* data, size_t n, double threshold,
+                                           double* out)
+{
+    const __m256d bound = _mm256_set1_pd(threshold);
+    const CompressTable& table = compressTable();
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d v = _mm256_loadu_pd(data + i);
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(v, bound, _CMP_GT_OQ));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written),
+                            _mm256_permutevar8x32_epi32(_mm256_castpd_si256(v), table.pairs(mask)));
+        written += __builtin_popcount(mask);
+    }
+    return written +
+           ScalarKernels<double>::filterGreater(data + i, n - i, threshold, out + written);
+}
+} // namespace avx2
+
+// Picks the widest instruction set supported by the running CPU.
+template <typename T>
+struct DispatchKernels
+{
+    static size_t find(const T* data, size_t n, T value)
+    {
+        return hasAvx2() ? avx2::find(data, n, value) : sse2::find(data, n, value);
+    }
+
+    static size_t count(const T* data, size_t n, T value)
+    {
+        return hasAvx2() ? avx2::count(data, n, value) : sse2::count(data, n, value);
+    }
+
+    static SumType<T> sum(const T* data, size_t n)
+    {
+        return hasAvx2() ? avx2::sum(data, n) : sse2::sum(data, n);
+    }
+
+    static void minMax(const T* data, size_t n, T& min, T& max)
+    {
+        if (hasAvx2())
+        {
+            avx2::minMax(data, n, min, max);
+        }
+        else
+        {
+            sse2::minMax(data, n, min, max);
+        }
+    }
+
+    static size_t filterGreater(const T* data, size_t n, T threshold, T* out)
+    {
+        return hasAvx2() ? avx2::filterGreater(data, n, threshold, out)
+                         : sse2::filterGreater(data, n, threshold, out);
+    }
+};
+
+template <typename T>
+struct Kernels : std::conditional<std::is_same<T, int32_t>::value ||
+                                      std::is_same<T, float>::value ||
+                                      std::is_same<T, double>::value,
+                                  DispatchKernels<T>, ScalarKernels<T>>::type
+{
+};
+
+#else
+
+template <typename T>
+struct Kernels : ScalarKernels<T>
+{
+};
+
+#endif
+} // namespace simd
+
+// Index of the first element equal to value, or array.size() if there is none.
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t find(const Array<T, Allocator, GrowthPolicy>& array, T value)
+{
+    static_assert(std::is_arithmetic<T>::value, "find() requires an arithmetic element type");
+    return simd::Kernels<T>::find(array.data(), array.size(), value);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+size_t count(const Array<T, Allocator, GrowthPolicy>& array, T value)
+{
+    static_assert(std::is_arithmetic<T>::value, "count() requires an arithmetic element type");
+    return simd::Kernels<T>::count(array.data(), array.size(), value);
+}
+
+// Floating point sums are accumulated in double and in a different order than a sequential loop.
+template <typename T, typename Allocator, typename GrowthPolicy>
+SumType<T> sum(const Array<T, Allocator, GrowthPolicy>& array)
+{
+    static_assert(std::is_arithmetic<T>::value, "sum() requires an arithmetic element type");
+    return simd::Kernels<T>::sum(array.data(), array.size());
+}
+
+// The result is unspecified if the array contains NaN.
+template <typename T, typename Allocator, typename GrowthPolicy>
+std::pair<T, T> minMax(const Array<T, Allocator, GrowthPolicy>& array)
+{
+    static_assert(std::is_arithmetic<T>::value, "minMax() requires an arithmetic element type");
+    if (array.isEmpty())
+    {
+        throw std::runtime_error("minMax() called on an empty array");
+    }
+
+    std::pair<T, T> result(array[0], array[0]);
+    simd::Kernels<T>::minMax(array.data(), array.size(), result.first, result.second);
+    return result;
+}
+
+// Appends to destination every element of source greater than threshold and returns how many were
+// appended. source and destination must be different arrays.
+template <typename T, typename Allocator, typename GrowthPolicy, typename DestinationAllocator,
+          typename DestinationGrowthPolicy>
+size_t filterInto(const Array<T, Allocator, GrowthPolicy>& source, T threshold,
+                  Array<T, DestinationAllocator, DestinationGrowthPolicy>& destination)
+{
+    static_assert(std::is_arithmetic<T>::value, "filterInto() requires an arithmetic element type");
+    // Each block is filtered into a scratch buffer that stays in L1 and then appended, so the
+    // destination is never zero-filled and grows with its growth policy like any append.
+    constexpr size_t BLOCK_SIZE = 1024;
+    T block[BLOCK_SIZE];
+    size_t start = destination.size();
+    for (size_t i = 0; i < source.size(); i += BLOCK_SIZE)
+    {
+        size_t n = source.size() - i < BLOCK_SIZE ? source.size() - i : BLOCK_SIZE;
+        size_t written = simd::Kernels<T>::filterGreater(source.data() + i, n, threshold, block);
+        destination.append(block, block + written);
+    }
+    return destination.size() - start;
+}
+} // namespace ds
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "FlatHashMap.h"
+#include "HashMapStats.h"
+#include "StringArena.h"
+
+namespace ds
+{
+
+// String-keyed map storing its keys in a StringArena instead of one std::string per entry. The
+// table is a FlatHashMap whose slots hold only the 32-bit offset of the key, its 32-bit hash and
+// the value, so a short key costs its bytes plus a one-byte prefix instead of a 32-byte
+// std::string and, past the small-string limit, a separate allocation. Keys are accepted as
+// std::string, const char*, std::string_view or StringRef and are only copied when inserted.
+// Erased keys keep their arena bytes until compact().
+template <typename Value>
+class CompactStringMap
+{
+    using Index = FlatHashMap<detail::ArenaKey, Value, detail::ArenaKeyHash, detail::ArenaKeyEqual>;
+
+  public:
+    class Iterator;
+    class ConstIterator;
+
+    CompactStringMap()
+        : arena(new StringArena()),
+          index(detail::ArenaKeyHash(), detail::ArenaKeyEqual(arena.get()))
+    {
+    }
+
+    CompactStringMap(const CompactStringMap<Value>& other)
+        : arena(new StringArena(*other.arena)),
+          index(detail::ArenaKeyHash(), detail::ArenaKeyEqual(arena.get()))
+    {
+        // The arena is copied byte for byte, so every offset still names the same key.
+        index.resize(slotsFor(other.size()));
+        for (auto it = other.index.begin(); it != other.index.end(); ++it)
+        {
+            index.insert(*it);
+        }
+    }
+
+    CompactStringMap(CompactStringMap<Value>&& other) noexcept
+        : arena(std::move(other.arena)), index(std::move(other.index))
+    {
+        other.reset();
+    }
+
+    CompactStringMap<Value>& operator=(const CompactStringMap<Value>& other)
+    {
+        if (this != &other)
+        {
+            *this = CompactStringMap<Value>(other);
+        }
+        return *this;
+    }
+
+    CompactStringMap<Value>& operator=(CompactStringMap<Value>&& other) noexcept
+    {
+        if (this != &other)
+        {
+            arena = std::move(other.arena);
+            index = std::move(other.index);
+            other.reset();
+        }
+        return *this;
+    }
+
+    size_t size() const
+    {
+        return index.size();
+    }
+
+    bool isEmpty() const
+    {
+        return index.isEmpty();
+    }
+
+    // Throws std::out_of_range if the key is absent.
+    Value& at(StringRef key) const
+    {
+        Value* value = find(key);
+        if (value == nullptr)
+        {
+            throw std::out_of_range("No value associated to the given key in CompactStringMap");
+        }
+        return *value;
+    }
+
+    // Returns the value of key, or nullptr if there is none.
+    Value* find(StringRef key) const
+    {
+        std::pair<const detail::ArenaKey, Value>* entry = index.find(detail::ArenaLookup(key));
+        return entry == nullptr ? nullptr : &entry->second;
+    }
+
+    bool contains(StringRef key) const
+    {
+        return index.contains(detail::ArenaLookup(key));
+    }
+
+    Value& operator[](StringRef key)
+    {
+        detail::ArenaLookup lookup(key);
+        std::pair<const detail::ArenaKey, Value>* entry = index.find(lookup);
+        if (entry != nullptr)
+        {
+            return entry->second;
+        }
+        return index[detail::ArenaKey{arena->append(key), lookup.hash}];
+    }
+
+    // Throws std::runtime_error if the key is already present.
+    void insert(StringRef key, Value value)
+    {
+        if (contains(key))
+        {
+            throw std::runtime_error(
+                "A value associated to this key already exists in CompactStringMap");
+        }
+        (*this)[key] = std::move(value);
+    }
+
+    // Returns true if the key was inserted, false if an existing value was replaced.
+    bool insertOrAssign(StringRef key, Value value)
+    {
+        size_t before = size();
+        (*this)[key] = std::move(value);
+        return size() != before;
+    }
+
+    void erase(StringRef key)
+    {
+        index.erase(detail::ArenaLookup(key));
+    }
+
+    void clear()
+    {
+        index.clear();
+        arena->clear();
+    }
+
+    // Sizes the table for entryCount entries and the arena for keyBytes bytes of keys.
+    void reserve(size_t entryCount, size_t keyBytes = 0)
+    {
+        index.resize(slotsFor(entryCount));
+        arena->reserve(keyBytes);
+    }
+
+    // Rebuilds the arena with only the keys still in the map, in table order, and releases the
+    // bytes of erased keys. Scanning the map afterwards reads the arena sequentially.
+    void compact()
+    {
+        StringArena compacted;
+        compacted.reserve(arena->size());
+        for (auto it = index.begin(); it != index.end(); ++it)
+        {
+            // The hash is unchanged, so the entry keeps its slot and the scan its place.
+            index.replaceKey(it, detail::ArenaKey{compacted.append(arena->get(it->first.offset)),
+                                                  it->first.hash});
+        }
+        compacted.shrinkToFit();
+        *arena = std::move(compacted);
+    }
+
+    // The shape of the table as FlatHashMap::statistics() reports it, with the arena, used or
+    // not, counted in memoryBytes.
+    HashTableStats statistics() const
+    {
+        HashTableStats table = index.statistics();
+        table.memoryBytes += sizeof(arena) + sizeof(StringArena) + arena->capacity();
+        return table;
+    }
+
+    // Iterators visit entries in table order and are invalidated by any insertion or erasure.
+    Iterator begin()
+    {
+        return Iterator(index.begin(), arena.get());
+    }
+
+    Iterator end()
+    {
+        return Iterator(index.end(), arena.get());
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(index.begin(), arena.get());
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(index.end(), arena.get());
+    }
+
+    ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const
+    {
+        return end();
+    }
+
+  private:
+    // FlatHashMap grows past 7/8 full.
+    static size_t slotsFor(size_t entryCount)
+    {
+        return entryCount + entryCount / 7 + 1;
+    }
+
+    // The arena lives on the heap so that the table's KeyEqual can point to it across moves.
+    std::unique_ptr<StringArena> arena;
+    Index index;
+
+    // Leaves a moved-from map empty and usable.
+    void reset()
+    {
+        arena.reset(new StringArena());
+        index = Index(detail::ArenaKeyHash(), detail::ArenaKeyEqual(arena.get()));
+    }
+};
+
+template <typename Value>
+class CompactStringMap<Value>::Iterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<StringRef, Value&>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::pair<StringRef, Value&>;
+
+    StringRef key() const
+    {
+        return arena->get(it->first.offset);
+    }
+    Value& value() const
+    {
+        return it->second;
+    }
+    reference operator*() const
+    {
+        return reference(key(), value());
+    }
+    bool operator==(const Iterator& other) const
+    {
+        return it == other.it;
+    }
+    bool operator!=(const Iterator& other) const
+    {
+        return it != other.it;
+    }
+    Iterator& operator++()
+    {
+        ++it;
+        return *this;
+    }
+    Iterator operator++(int)
+    {
+        Iterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
+  private:
+    Iterator(typename Index::Iterator iIt, const StringArena* iArena) : it(iIt), arena(iArena)
+    {
+    }
+
+    typename Index::Iterator it;
+    const StringArena* arena;
+
+    friend class CompactStringMap;
+};
+
+template <typename Value>
+class CompactStringMap<Value>::ConstIterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<StringRef, const Value&>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::pair<StringRef, const Value&>;
+
+    ConstIterator(const Iterator& other) : it(other.it), arena(other.arena)
+    {
+    }
+
+    StringRef key() const
+    {
+        return arena->get(it->first.offset);
+    }
+    const Value& value() const
+    {
+        return it->second;
+    }
+    reference operator*() const
+    {
+        return reference(key(), value());
+    }
+    bool operator==(const ConstIterator& other) const
+    {
+        return it == other.it;
+    }
+    bool operator!=(const ConstIterator& other) const
+    {
+        return it != other.it;
+    }
+    ConstIterator& operator++()
+    {
+        ++it;
+        return *this;
+    }
+    ConstIterator operator++(int)
+    {
+        ConstIterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
+  private:
+    ConstIterator(typename Index::ConstIterator iIt, const StringArena* iArena)
+        : it(iIt), arena(iArena)
+    {
+    }
+
+    typename Index::ConstIterator it;
+    const StringArena* arena;
+
+    friend class CompactStringMap;
+};
+} // namespace ds
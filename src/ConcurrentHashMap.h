@@ -0,0 +1,173 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "Hash.h"
+#include "HashMap.h"
+
+namespace ds
+{
+
+// Thread-safe HashMap built with lock striping: keys are spread over independent segments, each a
+// HashMap guarded by its own reader-writer lock. Readers of a segment proceed in parallel, writers
+// only block their own segment, and a segment grows under its own lock while the others keep
+// serving. Values are returned by copy since a reference could outlive the lock.
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename KeyEqual = EqualTo<Key>>
+class ConcurrentHashMap
+{
+  public:
+    using ValueType = std::pair<const Key, Value>;
+
+    // The segment count is rounded up to a power of two. A few times the number of threads keeps
+    // the chance of two threads hitting the same segment low.
+    explicit ConcurrentHashMap(size_t segmentCount = DEFAULT_SEGMENTS,
+                               const Hasher& iHasher = Hasher(),
+                               const KeyEqual& iKeyEqual = KeyEqual())
+        : hasher(iHasher)
+    {
+        while ((size_t{1} << segmentBits) < segmentCount)
+        {
+            ++segmentBits;
+        }
+        segments.reset(new Segment[size_t{1} << segmentBits]);
+        for (size_t i = 0; i < (size_t{1} << segmentBits); ++i)
+        {
+            segments[i].map = HashMap<Key, Value, Hasher, KeyEqual>(iHasher, iKeyEqual);
+        }
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap<Key, Value, Hasher, KeyEqual>&) = delete;
+    ConcurrentHashMap<Key, Value, Hasher, KeyEqual>&
+    operator=(const ConcurrentHashMap<Key, Value, Hasher, KeyEqual>&) = delete;
+
+    // Not atomic with respect to concurrent writers: segments are counted one after the other.
+    size_t size() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < segmentCount(); ++i)
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(segments[i].mutex);
+            total += segments[i].map.size();
+        }
+        return total;
+    }
+
+    bool isEmpty() const
+    {
+        return size() == 0;
+    }
+
+    size_t segmentCount() const
+    {
+        return size_t{1} << segmentBits;
+    }
+
+    // Every operation hashes its key once: the hash picks the segment and is handed to the
+    // segment's map.
+    Value at(const Key& key) const
+    {
+        size_t hash = hasher(key);
+        Segment& segment = segmentFor(hash);
+        std::shared_lock<std::shared_timed_mutex> lock(segment.mutex);
+        ValueType* entry = segment.map.findHashed(hash, key);
+        if (entry == nullptr)
+        {
+            throw std::out_of_range("No value associated to the given key in ConcurrentHashMap");
+        }
+        return entry->second;
+    }
+
+    // Throws std::runtime_error if the key is already present.
+    void insert(const ValueType& pair)
+    {
+        size_t hash = hasher(pair.first);
+        Segment& segment = segmentFor(hash);
+        std::unique_lock<std::shared_timed_mutex> lock(segment.mutex);
+        if (!segment.map.tryEmplaceHashed(hash, pair.first, pair.second).second)
+        {
+            throw std::runtime_error(
+                "A value associated to this key already exists in ConcurrentHashMap");
+        }
+    }
+
+    // Returns true if the key was inserted, false if an existing value was replaced.
+    bool insertOrAssign(const Key& key, const Value& value)
+    {
+        size_t hash = hasher(key);
+        Segment& segment = segmentFor(hash);
+        std::unique_lock<std::shared_timed_mutex> lock(segment.mutex);
+        return segment.map.insertOrAssignHashed(hash, key, value).second;
+    }
+
+    // Returns the value of key, first storing fn(key) if the key is absent. fn runs under the
+    // segment's lock, so it is called at most once per key and must not use this map.
+    template <typename Fn>
+    Value computeIfAbsent(const Key& key, Fn fn)
+    {
+        size_t hash = hasher(key);
+        Segment& segment = segmentFor(hash);
+        std::unique_lock<std::shared_timed_mutex> lock(segment.mutex);
+        std::pair<ValueType&, bool> result = segment.map.tryEmplaceHashed(hash, key);
+        Value& value = result.first.second;
+        if (result.second)
+        {
+            try
+            {
+                value = fn(key);
+            }
+            catch (...)
+            {
+                segment.map.eraseHashed(hash, key);
+                throw;
+            }
+        }
+        return value;
+    }
+
+    // Returns true if the key was present.
+    bool erase(const Key& key)
+    {
+        size_t hash = hasher(key);
+        Segment& segment = segmentFor(hash);
+        std::unique_lock<std::shared_timed_mutex> lock(segment.mutex);
+        return segment.map.eraseHashed(hash, key);
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < segmentCount(); ++i)
+        {
+            std::unique_lock<std::shared_timed_mutex> lock(segments[i].mutex);
+            segments[i].map.clear();
+        }
+    }
+
+  private:
+    constexpr static size_t DEFAULT_SEGMENTS = 64;
+    constexpr static size_t CACHE_LINE_SIZE = 64;
+
+    struct Segment
+    {
+        mutable std::shared_timed_mutex mutex;
+        HashMap<Key, Value, Hasher, KeyEqual> map;
+        // Keeps the lock of one segment off the cache lines of its neighbours.
+        char padding[CACHE_LINE_SIZE];
+    };
+
+    Hasher hasher;
+    std::unique_ptr<Segment[]> segments;
+    unsigned segmentBits = 0;
+
+    // Segments are picked with the low bits of the mixed hash; the maps index their buckets with
+    // the top bits, so both stay evenly spread.
+    Segment& segmentFor(size_t hash) const
+    {
+        return segments[mixHash(hash) & ((size_t{1} << segmentBits) - 1)];
+    }
+};
+} // namespace ds
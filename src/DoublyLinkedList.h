@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace ds
 {
@@ -54,50 +55,78 @@ class DoublyLinkedList
         return *this;
     }
 
-    ~DoublyLinkedList() = default;
+    ~DoublyLinkedList()
+    {
+        clear();
+    }
 
     bool isEmpty() const
     {
         return !head;
     }
 
+    // Frees the nodes one by one: letting head's destructor free the rest would recurse once per
+    // node and overflow the stack on long lists.
     void clear()
     {
-        head.reset();
+        while (head)
+        {
+            head = std::move(head->next);
+        }
         tail = nullptr;
     }
 
     void pushFront(const T& data)
     {
-        auto newNode = std::make_unique<Node>(data, std::move(head), nullptr);
+        emplaceFront(data);
+    }
 
-        if (newNode->next)
-        {
-            newNode->next->prev = newNode.get();
-        }
+    void pushFront(T&& data)
+    {
+        emplaceFront(std::move(data));
+    }
 
-        head = std::move(newNode);
+    void pushBack(const T& data)
+    {
+        emplaceBack(data);
+    }
 
-        if (!tail)
-        {
-            tail = head.get();
-        }
+    void pushBack(T&& data)
+    {
+        emplaceBack(std::move(data));
     }
 
-    void pushBack(const T& data)
+    template <typename... Args>
+    T& emplaceFront(Args&&... args)
     {
-        auto newNode = std::make_unique<Node>(data, nullptr, tail);
+        Node* node = link(head.get(), std::make_unique<Node>(std::forward<Args>(args)...));
+        return node->data;
+    }
 
-        if (!head)
-        {
-            head = std::move(newNode);
-            tail = head.get();
-        }
-        else
+    template <typename... Args>
+    T& emplaceBack(Args&&... args)
+    {
+        Node* node = link(nullptr, std::make_unique<Node>(std::forward<Args>(args)...));
+        return node->data;
+    }
+
+    // Constructs an element in front of position.
+    template <typename... Args>
+    Iterator emplace(Iterator position, Args&&... args)
+    {
+        return Iterator(
+            link(position.currentNode, std::make_unique<Node>(std::forward<Args>(args)...)));
+    }
+
+    // Moves the node of it, which belongs to other, in front of position without copying or
+    // reallocating the element. other may be this list.
+    void splice(Iterator position, DoublyLinkedList<T>& other, Iterator it)
+    {
+        if (it.currentNode == position.currentNode)
         {
-            tail->next = std::move(newNode);
-            tail = tail->next.get();
+            return;
         }
+        link(position.currentNode, other.unlink(it.currentNode));
     }
 
     T popFront()
@@ -115,6 +144,10 @@ class DoublyLinkedList
         {
             tail = nullptr;
         }
+        else
+        {
+            head->prev = nullptr;
+        }
 
         return data;
     }
@@ -169,34 +202,7 @@ class DoublyLinkedList
             return;
         }
 
-        Node* prev = itToDelete.currentNode->prev;
-        std::unique_ptr<Node> nodeToDelete = std::move(prev != nullptr ? prev->next : head);
-
-        if (prev == nullptr)
-        {
-            head = std::move(nodeToDelete->next);
-            if (!head)
-            {
-                tail = nullptr;
-            }
-            else
-            {
-                head->prev = nullptr;
-            }
-            return;
-        }
-
-        prev->next = std::move(nodeToDelete->next);
-        Node* next = prev->next.get();
-
-        if (next != nullptr)
-        {
-            next->prev = prev;
-        }
-        else
-        {
-            tail = prev;
-        }
+        unlink(itToDelete.currentNode);
     }
 
     Iterator begin()
@@ -239,33 +245,81 @@ class DoublyLinkedList
         return ConstIterator(nullptr);
     }
 
+    // Bytes allocated for each element, not counting the allocator's own overhead.
+    static size_t nodeSize()
+    {
+        return sizeof(Node);
+    }
+
   private:
     class Node
     {
       public:
-        explicit Node(const T& iData, std::unique_ptr<Node> iNext, Node* iPrev)
-            : data(iData), next(std::move(iNext)), prev(iPrev)
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(std::forward<Args>(args)...)
         {
         }
 
         T data;
         std::unique_ptr<Node> next;
-        Node* prev;
+        Node* prev = nullptr;
     };
 
     std::unique_ptr<Node> head;
     Node* tail = nullptr;
+
+    // Links node in front of position, or at the back if position is null, and returns it.
+    Node* link(Node* position, std::unique_ptr<Node> node)
+    {
+        Node* linked = node.get();
+        Node* prev = position != nullptr ? position->prev : tail;
+        std::unique_ptr<Node>& slot = prev != nullptr ? prev->next : head;
+
+        linked->prev = prev;
+        linked->next = std::move(slot);
+        slot = std::move(node);
+
+        if (position != nullptr)
+        {
+            position->prev = linked;
+        }
+        else
+        {
+            tail = linked;
+        }
+        return linked;
+    }
+
+    std::unique_ptr<Node> unlink(Node* node)
+    {
+        Node* prev = node->prev;
+        std::unique_ptr<Node>& slot = prev != nullptr ? prev->next : head;
+        std::unique_ptr<Node> unlinked = std::move(slot);
+
+        slot = std::move(unlinked->next);
+        if (slot)
+        {
+            slot->prev = prev;
+        }
+        else
+        {
+            tail = prev;
+        }
+
+        unlinked->prev = nullptr;
+        return unlinked;
+    }
 };
 
 template <typename T>
 class DoublyLinkedList<T>::Iterator
 {
   public:
-    T& operator*()
+    T& operator*() const
     {
         return currentNode->data;
     }
-    T* operator->()
+    T* operator->() const
     {
         return &currentNode->data;
     }
@@ -0,0 +1,663 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+#include "Hash.h"
+#include "HashMapStats.h"
+
+namespace ds
+{
+
+// Open-addressing counterpart of HashMap with the same interface. Entries are stored inline in a
+// single flat array and placed with Robin Hood hashing: an entry that is further from its home slot
+// takes the place of one that is closer, which keeps probe sequences short and lets a lookup stop
+// as soon as it meets an entry closer to home than the key would be. Erasing shifts the following
+// entries back instead of leaving tombstones. Inserting or erasing moves other entries, so
+// references into the map are only stable until the next insertion or erasure. Heterogeneous
+// lookup and the Stats policy work as in HashMap.
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename KeyEqual = EqualTo<Key>, typename Stats = NoStats>
+class FlatHashMap
+{
+    template <typename K, typename H = Hasher>
+    using EnableIfTransparent =
+        typename std::enable_if<IsTransparent<H>::value && IsTransparent<KeyEqual>::value &&
+                                !std::is_same<K, Key>::value>::type;
+
+  public:
+    using ValueType = std::pair<const Key, Value>;
+    class Iterator;
+    class ConstIterator;
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(const Hasher& iHasher, const KeyEqual& iKeyEqual = KeyEqual())
+        : hasher(iHasher), keyEqual(iKeyEqual)
+    {
+    }
+
+    FlatHashMap(const FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>& other)
+        : hasher(other.hasher), keyEqual(other.keyEqual), stats(other.stats)
+    {
+        copyFrom(other);
+    }
+
+    FlatHashMap(FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>&& other) noexcept
+        : hasher(other.hasher), keyEqual(other.keyEqual), slots(std::move(other.slots)),
+          capacity(other.capacity), count(other.count), shift(other.shift), stats(other.stats)
+    {
+        other.capacity = 0;
+        other.count = 0;
+    }
+
+    ~FlatHashMap()
+    {
+        destroyAll();
+    }
+
+    FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>&
+    operator=(const FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>& other)
+    {
+        if (this != &other)
+        {
+            FlatHashMap<Key, Value, Hasher, KeyEqual, Stats> copy(other);
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>&
+    operator=(FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroyAll();
+            hasher = other.hasher;
+            keyEqual = other.keyEqual;
+            slots = std::move(other.slots);
+            capacity = other.capacity;
+            count = other.count;
+            shift = other.shift;
+            stats = other.stats;
+
+            other.capacity = 0;
+            other.count = 0;
+        }
+
+        return *this;
+    }
+
+    void swap(FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>& other) noexcept
+    {
+        using std::swap;
+
+        swap(hasher, other.hasher);
+        swap(keyEqual, other.keyEqual);
+        slots.swap(other.slots);
+        swap(capacity, other.capacity);
+        swap(count, other.count);
+        swap(shift, other.shift);
+        swap(stats, other.stats);
+    }
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    Value& at(const Key& key) const
+    {
+        return atImpl(key);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    Value& at(const K& key) const
+    {
+        return atImpl(key);
+    }
+
+    // Returns the entry with the given key, or nullptr if there is none.
+    ValueType* find(const Key& key) const
+    {
+        return findImpl(key);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    ValueType* find(const K& key) const
+    {
+        return findImpl(key);
+    }
+
+    bool contains(const Key& key) const
+    {
+        return findIndex(key) != NOT_FOUND;
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    bool contains(const K& key) const
+    {
+        return findIndex(key) != NOT_FOUND;
+    }
+
+    Value& operator[](const Key& key)
+    {
+        return subscriptImpl(key);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    Value& operator[](const K& key)
+    {
+        return subscriptImpl(key);
+    }
+
+    void clear()
+    {
+        destroyAll();
+        count = 0;
+    }
+
+    ValueType& insert(const ValueType& pair)
+    {
+        if (findIndex(pair.first) != NOT_FOUND)
+        {
+            throw std::runtime_error(
+                "A value associated to this key already exists in FlatHashMap");
+        }
+
+        growIfNeeded();
+        return entry(insertNew(homeIndex(pair.first), pair));
+    }
+
+    void erase(const Key& key)
+    {
+        eraseImpl(key);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    void erase(const K& key)
+    {
+        eraseImpl(key);
+    }
+
+    // Gives the entry at position a new key, keeping its value, its slot and every iterator. The
+    // new key must hash to the same value as the old one and must not equal any other key of the
+    // map. If copying the key throws, the entry is erased.
+    void replaceKey(Iterator position, const Key& key)
+    {
+        size_t index = position.current - slotData();
+        ValueType* old = stored(index);
+        Value value(std::move(old->second));
+        old->~ValueType();
+        try
+        {
+            new (old) ValueType(key, std::move(value));
+        }
+        catch (...)
+        {
+            slots[index].distance = 0;
+            shiftBack(index);
+            --count;
+            throw;
+        }
+    }
+
+    // Capacities are rounded up to a power of two.
+    void resize(size_t newCapacity)
+    {
+        if (newCapacity <= capacity)
+        {
+            return;
+        }
+
+        size_t rounded = MIN_SIZE;
+        while (rounded < newCapacity)
+        {
+            rounded *= 2;
+        }
+        rehash(rounded);
+    }
+
+    // Scans the whole table to measure probe distances, so it costs O(capacity).
+    HashTableStats statistics() const
+    {
+        HashTableStats table;
+        table.size = count;
+        table.bucketCount = capacity;
+        table.loadFactor = capacity == 0 ? 0 : static_cast<float>(count) / capacity;
+        table.memoryBytes = sizeof(*this) + capacity * sizeof(Slot);
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            if (slots[i].distance == 0)
+            {
+                continue;
+            }
+            size_t distance = slots[i].distance - 1;
+            if (distance >= table.probeDistances.size())
+            {
+                table.probeDistances.resize(distance + 1);
+            }
+            ++table.probeDistances[distance];
+        }
+        stats.report(table);
+        return table;
+    }
+
+    // Iterators walk the slot array in order and are invalidated by any insertion or erasure.
+    Iterator begin()
+    {
+        return Iterator(slotData(), slotData() + capacity);
+    }
+
+    Iterator end()
+    {
+        return Iterator(slotData() + capacity, slotData() + capacity);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(Iterator(slotData(), slotData() + capacity));
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(Iterator(slotData() + capacity, slotData() + capacity));
+    }
+
+    ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const
+    {
+        return end();
+    }
+
+  private:
+    using Storage = typename std::aligned_storage<sizeof(ValueType), alignof(ValueType)>::type;
+
+    // Entries are stored as ValueType. Their key is const, so an entry changes slot by being
+    // constructed anew and destroyed in place rather than by assignment, which copies the key.
+    struct Slot
+    {
+        // 0 for an empty slot, otherwise 1 + the distance from the entry's home slot.
+        uint32_t distance;
+        Storage storage;
+    };
+
+    constexpr static size_t MIN_SIZE = 16;
+    constexpr static size_t NOT_FOUND = static_cast<size_t>(-1);
+    // The table grows past 7/8 full; Robin Hood keeps probes short up to high load factors.
+    constexpr static size_t MAX_LOAD_NUMERATOR = 7;
+    constexpr static size_t MAX_LOAD_DENOMINATOR = 8;
+    Hasher hasher;
+    KeyEqual keyEqual;
+    Array<Slot> slots;
+    size_t capacity = 0;
+    size_t count = 0;
+    unsigned shift = 64;
+    mutable Stats stats;
+
+    Slot* slotData() const
+    {
+        return capacity == 0 ? nullptr : &slots[0];
+    }
+
+    ValueType* stored(size_t index) const
+    {
+        return reinterpret_cast<ValueType*>(&slots[index].storage);
+    }
+
+    ValueType& entry(size_t index) const
+    {
+        return *stored(index);
+    }
+
+    static void relocate(ValueType* from, ValueType* to)
+    {
+        new (to) ValueType(std::move(*from));
+        from->~ValueType();
+    }
+
+    // Fibonacci hashing: the multiplication spreads the bits of weak hashes such as the identity
+    // std::hash of integers before the top bits are taken as the index.
+    template <typename K>
+    size_t homeIndex(const K& key) const
+    {
+        uint64_t hash = static_cast<uint64_t>(hasher(key));
+        return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    template <typename K>
+    Value& atImpl(const K& key) const
+    {
+        size_t index = findIndex(key);
+        if (index == NOT_FOUND)
+        {
+            throw std::out_of_range("No value associated to the given key in FlatHashMap");
+        }
+
+        return entry(index).second;
+    }
+
+    template <typename K>
+    ValueType* findImpl(const K& key) const
+    {
+        size_t index = findIndex(key);
+        return index != NOT_FOUND ? &entry(index) : nullptr;
+    }
+
+    template <typename K>
+    Value& subscriptImpl(const K& key)
+    {
+        size_t index = findIndex(key);
+        if (index != NOT_FOUND)
+        {
+            return entry(index).second;
+        }
+
+        growIfNeeded();
+        return entry(insertNew(homeIndex(key), std::piecewise_construct, std::forward_as_tuple(key),
+                               std::forward_as_tuple()))
+            .second;
+    }
+
+    template <typename K>
+    void eraseImpl(const K& key)
+    {
+        size_t index = findIndex(key);
+        if (index == NOT_FOUND)
+        {
+            return;
+        }
+
+        stored(index)->~ValueType();
+        slots[index].distance = 0;
+        shiftBack(index);
+        --count;
+    }
+
+    // Fills the hole left at an emptied slot: every following entry that is not in its home slot
+    // moves one step closer.
+    void shiftBack(size_t index)
+    {
+        size_t next = (index + 1) & (capacity - 1);
+        while (slots[next].distance > 1)
+        {
+            relocate(stored(next), stored(index));
+            slots[index].distance = slots[next].distance - 1;
+            slots[next].distance = 0;
+            index = next;
+            next = (next + 1) & (capacity - 1);
+        }
+    }
+
+    template <typename K>
+    size_t findIndex(const K& key) const
+    {
+        stats.countLookup();
+        if (count == 0)
+        {
+            return NOT_FOUND;
+        }
+
+        size_t index = homeIndex(key);
+        for (uint32_t distance = 1;; ++distance)
+        {
+            const Slot& slot = slots[index];
+            if (slot.distance < distance)
+            {
+                return NOT_FOUND;
+            }
+            if (slot.distance == distance)
+            {
+                stats.countComparison();
+                if (keyEqual(stored(index)->first, key))
+                {
+                    return index;
+                }
+            }
+            index = (index + 1) & (capacity - 1);
+        }
+    }
+
+    // Constructs an entry whose key is known to be absent and whose home slot is index, and returns
+    // its slot. The table must have room for it. The entry goes where Robin Hood would carry it:
+    // the first slot that is empty or holds an entry closer to home. The entries from there to the
+    // next empty slot move one step forward, which keeps every run ordered by home slot.
+    template <typename... Args>
+    size_t insertNew(size_t index, Args&&... args)
+    {
+        uint32_t distance = 1;
+        while (slots[index].distance >= distance)
+        {
+            index = (index + 1) & (capacity - 1);
+            ++distance;
+        }
+
+        size_t last = index;
+        while (slots[last].distance != 0)
+        {
+            last = (last + 1) & (capacity - 1);
+        }
+        while (last != index)
+        {
+            size_t previous = (last - 1) & (capacity - 1);
+            relocate(stored(previous), stored(last));
+            slots[last].distance = slots[previous].distance + 1;
+            slots[previous].distance = 0;
+            last = previous;
+        }
+
+        try
+        {
+            new (stored(index)) ValueType(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            shiftBack(index);
+            throw;
+        }
+        slots[index].distance = distance;
+        ++count;
+        return index;
+    }
+
+    void growIfNeeded()
+    {
+        if ((count + 1) * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR)
+        {
+            rehash(capacity == 0 ? MIN_SIZE : capacity * 2);
+        }
+    }
+
+    void rehash(size_t newCapacity)
+    {
+        stats.countRehash();
+        typename Stats::Timer timer(stats);
+        Array<Slot> oldSlots;
+        oldSlots.swap(slots);
+        size_t oldCapacity = capacity;
+
+        slots.resize(newCapacity);
+        capacity = newCapacity;
+        count = 0;
+        shift = 64;
+        for (size_t i = newCapacity; i > 1; i /= 2)
+        {
+            --shift;
+        }
+
+        for (size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldSlots[i].distance != 0)
+            {
+                ValueType* old = reinterpret_cast<ValueType*>(&oldSlots[i].storage);
+                insertNew(homeIndex(old->first), std::move(*old));
+                old->~ValueType();
+            }
+        }
+    }
+
+    void copyFrom(const FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>& other)
+    {
+        if (other.count == 0)
+        {
+            return;
+        }
+
+        slots.resize(other.capacity);
+        capacity = other.capacity;
+        shift = other.shift;
+        try
+        {
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                if (other.slots[i].distance != 0)
+                {
+                    new (stored(i)) ValueType(*other.stored(i));
+                    slots[i].distance = other.slots[i].distance;
+                    ++count;
+                }
+            }
+        }
+        catch (...)
+        {
+            destroyAll();
+            throw;
+        }
+    }
+
+    void destroyAll()
+    {
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            if (slots[i].distance != 0)
+            {
+                stored(i)->~ValueType();
+                slots[i].distance = 0;
+            }
+        }
+    }
+};
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual, typename Stats>
+class FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>::Iterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType*;
+    using reference = ValueType&;
+
+    reference operator*() const
+    {
+        return *operator->();
+    }
+    pointer operator->() const
+    {
+        return reinterpret_cast<ValueType*>(&current->storage);
+    }
+    bool operator==(const Iterator& other) const
+    {
+        return current == other.current;
+    }
+    bool operator!=(const Iterator& other) const
+    {
+        return current != other.current;
+    }
+    Iterator& operator++()
+    {
+        ++current;
+        skipEmptySlots();
+        return *this;
+    }
+    Iterator operator++(int)
+    {
+        Iterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
+  private:
+    Iterator(Slot* iCurrent, Slot* iLast) : current(iCurrent), last(iLast)
+    {
+        skipEmptySlots();
+    }
+
+    void skipEmptySlots()
+    {
+        while (current != last && current->distance == 0)
+        {
+            ++current;
+        }
+    }
+
+    Slot* current;
+    Slot* last;
+
+    friend class FlatHashMap;
+};
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual, typename Stats>
+class FlatHashMap<Key, Value, Hasher, KeyEqual, Stats>::ConstIterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ValueType*;
+    using reference = const ValueType&;
+
+    ConstIterator(const Iterator& other) : it(other)
+    {
+    }
+
+    reference operator*() const
+    {
+        return *it;
+    }
+    pointer operator->() const
+    {
+        return &*it;
+    }
+    bool operator==(const ConstIterator& other) const
+    {
+        return it == other.it;
+    }
+    bool operator!=(const ConstIterator& other) const
+    {
+        return it != other.it;
+    }
+    ConstIterator& operator++()
+    {
+        ++it;
+        return *this;
+    }
+    ConstIterator operator++(int)
+    {
+        ConstIterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
+  private:
+    Iterator it;
+};
+} // namespace ds
@@ -0,0 +1,491 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "Array.h"
+#include "Hash.h"
+#include "HashMap.h"
+#include "MappedArray.h"
+
+namespace ds
+{
+
+// Immutable map built once from a set of pairs, for tables that are read far more often than they
+// change. Keys are placed with a minimal perfect hash in the style of CHD and PTHash: keys are
+// split into buckets of about four, and each bucket stores a pilot chosen at build time so that
+// hashing its keys together with the pilot sends every one of them to a distinct slot. A lookup
+// hashes the key once, reads the pilot of its bucket and then exactly one entry; it never probes
+// and never divides. The whole map lives in one contiguous buffer that save() writes as is and
+// load() maps back read-only, so another process can use it without rebuilding it.
+//
+// Keys and values are copied byte for byte into the buffer, hence must be trivially copyable; keys
+// are hashed and compared by their bytes, so they must not contain padding.
+template <typename Key, typename Value>
+class FrozenHashMap
+{
+  public:
+    struct Entry
+    {
+        Key first;
+        Value second;
+    };
+
+    static_assert(std::is_trivially_copyable<Key>::value &&
+                      std::is_trivially_copyable<Value>::value,
+                  "FrozenHashMap requires trivially copyable keys and values");
+
+    FrozenHashMap() = default;
+
+    // Builds the map from a range of pairs with distinct keys, e.g. the iterators of a HashMap.
+    // Throws std::runtime_error if a key appears twice.
+    template <typename InputIt>
+    FrozenHashMap(InputIt first, InputIt last)
+    {
+        Array<Entry> entries;
+        for (; first != last; ++first)
+        {
+            entries.pushBack(Entry{first->first, first->second});
+        }
+        build(entries);
+    }
+
+    FrozenHashMap(const FrozenHashMap<Key, Value>&) = delete;
+    FrozenHashMap<Key, Value>& operator=(const FrozenHashMap<Key, Value>&) = delete;
+
+    FrozenHashMap(FrozenHashMap<Key, Value>&& other) noexcept
+        : owned(std::move(other.owned)), mapped(std::move(other.mapped)), buffer(other.buffer),
+          words(other.words), pilots(other.pilots), entries(other.entries), count(other.count),
+          bucketCount(other.bucketCount), seed(other.seed)
+    {
+        other.detach();
+    }
+
+    FrozenHashMap<Key, Value>& operator=(FrozenHashMap<Key, Value>&& other) noexcept
+    {
+        if (this != &other)
+        {
+            owned = std::move(other.owned);
+            mapped = std::move(other.mapped);
+            buffer = other.buffer;
+            words = other.words;
+            pilots = other.pilots;
+            entries = other.entries;
+            count = other.count;
+            bucketCount = other.bucketCount;
+            seed = other.seed;
+            other.detach();
+        }
+
+        return *this;
+    }
+
+    // Maps a file written by save(). Pages are only read when a lookup touches them.
+    static FrozenHashMap<Key, Value> load(const std::string& path)
+    {
+        FrozenHashMap<Key, Value> map;
+        map.mapped.reset(new MappedArray<uint64_t>(path, MapMode::ReadOnly));
+        map.attach(map.mapped->data(), map.mapped->size(), path);
+        return map;
+    }
+
+    void save(const std::string& path) const
+    {
+        MappedArray<uint64_t> file(path, MapMode::ReadWrite);
+        file.clear();
+        file.resize(words);
+        if (words != 0)
+        {
+            std::memcpy(file.data(), buffer, words * sizeof(uint64_t));
+        }
+        file.sync();
+    }
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    // Returns the entry with the given key, or nullptr if there is none.
+    const Entry* find(const Key& key) const
+    {
+        if (count == 0)
+        {
+            return nullptr;
+        }
+
+        uint64_t hash = hashKey(key, seed);
+        const Entry* entry = entries + slotFor(hash, pilots[bucketFor(hash, bucketCount)], count);
+        return std::memcmp(&entry->first, &key, sizeof(Key)) == 0 ? entry : nullptr;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    const Value& at(const Key& key) const
+    {
+        const Entry* entry = find(key);
+        if (entry == nullptr)
+        {
+            throw std::out_of_range("No value associated to the given key in FrozenHashMap");
+        }
+
+        return entry->second;
+    }
+
+    // Entries are in slot order.
+    const Entry* begin() const
+    {
+        return entries;
+    }
+
+    const Entry* end() const
+    {
+        return entries + count;
+    }
+
+  private:
+    constexpr static size_t CACHE_LINE_SIZE = 64;
+    constexpr static uint64_t MAGIC = 0x4E455A4F52465344ull; // "DSFROZEN"
+    constexpr static uint32_t VERSION = 1;
+    // Average number of keys per pilot.
+    constexpr static size_t KEYS_PER_BUCKET = 4;
+    // Seeds tried before giving up on building the map.
+    constexpr static uint32_t MAX_ATTEMPTS = 32;
+
+    // Start of the buffer, one cache line.
+    struct Header
+    {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t entrySize;
+        uint32_t keySize;
+        uint32_t valueSize;
+        uint64_t count;
+        uint64_t bucketCount;
+        uint64_t seed;
+        uint64_t entriesOffset;
+        uint64_t reserved;
+    };
+
+    static_assert(sizeof(Header) == CACHE_LINE_SIZE, "FrozenHashMap header must fill a cache line");
+    static_assert(alignof(Entry) <= CACHE_LINE_SIZE, "FrozenHashMap entries are over-aligned");
+
+    // Owns the buffer of a built map; a loaded one points into mapped instead.
+    Array<uint64_t> owned;
+    std::unique_ptr<MappedArray<uint64_t>> mapped;
+    const uint64_t* buffer = nullptr;
+    size_t words = 0;
+    const uint32_t* pilots = nullptr;
+    const Entry* entries = nullptr;
+    size_t count = 0;
+    size_t bucketCount = 0;
+    uint64_t seed = 0;
+
+    void detach()
+    {
+        buffer = nullptr;
+        words = 0;
+        pilots = nullptr;
+        entries = nullptr;
+        count = 0;
+        bucketCount = 0;
+        seed = 0;
+    }
+
+    const Header* header() const
+    {
+        return reinterpret_cast<const Header*>(buffer);
+    }
+
+    static uint64_t mix64(uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    // Maps a 32-bit hash to [0, n) with a multiplication instead of a division.
+    static uint32_t reduce(uint32_t hash, size_t n)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(hash) * n) >> 32);
+    }
+
+    static uint64_t hashKey(const Key& key, uint64_t keySeed)
+    {
+        return static_cast<uint64_t>(hashBytes(&key, sizeof(Key), keySeed));
+    }
+
+    static uint32_t bucketFor(uint64_t hash, size_t buckets)
+    {
+        return reduce(static_cast<uint32_t>(hash), buckets);
+    }
+
+    // Multiplying by an odd factor derived from the pilot moves the differences between the hashes
+    // of a bucket into the high bits, which pick the slot, in a different way for every pilot.
+    static uint32_t slotFor(uint64_t hash, uint32_t pilot, size_t slots)
+    {
+        uint64_t factor = (pilot * 0x9E3779B97F4A7C15ull) | 1;
+        return reduce(static_cast<uint32_t>((hash * factor) >> 32), slots);
+    }
+
+    static size_t roundUpToLine(size_t bytes)
+    {
+        return (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    }
+
+    void build(const Array<Entry>& input)
+    {
+        if (input.size() > UINT32_MAX)
+        {
+            throw std::runtime_error("FrozenHashMap holds at most 2^32 - 1 entries");
+        }
+        if (input.isEmpty())
+        {
+            return;
+        }
+
+        size_t slots = input.size();
+        size_t buckets = (slots + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+        Array<uint32_t> chosen;
+        Array<uint32_t> slotOf;
+        uint64_t keySeed = 0;
+        for (uint32_t attempt = 0;; ++attempt)
+        {
+            if (attempt == MAX_ATTEMPTS)
+            {
+                throw std::runtime_error("Cannot build a perfect hash for FrozenHashMap");
+            }
+            keySeed = mix64(attempt + 1);
+            if (place(input, keySeed, buckets, chosen, slotOf))
+            {
+                break;
+            }
+        }
+
+        size_t entriesOffset = roundUpToLine(sizeof(Header) + buckets * sizeof(uint32_t));
+        size_t bytes = entriesOffset + slots * sizeof(Entry);
+        size_t totalWords = (bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        // Over-allocates by a cache line so that the buffer, hence every entry, can be aligned.
+        const size_t lineWords = CACHE_LINE_SIZE / sizeof(uint64_t);
+        owned.resize(totalWords + lineWords - 1);
+        uintptr_t address = reinterpret_cast<uintptr_t>(&owned[0]);
+        size_t skip = (CACHE_LINE_SIZE - address % CACHE_LINE_SIZE) % CACHE_LINE_SIZE;
+        uint64_t* start = &owned[skip / sizeof(uint64_t)];
+        unsigned char* bytePointer = reinterpret_cast<unsigned char*>(start);
+
+        Header fields{MAGIC,
+                      VERSION,
+                      static_cast<uint32_t>(sizeof(Entry)),
+                      static_cast<uint32_t>(sizeof(Key)),
+                      static_cast<uint32_t>(sizeof(Value)),
+                      slots,
+                      buckets,
+                      keySeed,
+                      entriesOffset,
+                      0};
+        std::memcpy(bytePointer, &fields, sizeof(Header));
+        std::memcpy(bytePointer + sizeof(Header), &chosen[0], buckets * sizeof(uint32_t));
+        for (size_t i = 0; i < slots; ++i)
+        {
+            std::memcpy(bytePointer + entriesOffset + slotOf[i] * sizeof(Entry), &input[i],
+                        sizeof(Entry));
+        }
+
+        attach(start, totalWords, "FrozenHashMap buffer");
+    }
+
+    // Finds a pilot for every bucket such that all keys land in distinct slots. The largest buckets
+    // go first, while most slots are free. Returns false if the seed does not work.
+    static bool place(const Array<Entry>& input, uint64_t keySeed, size_t buckets,
+                      Array<uint32_t>& chosen, Array<uint32_t>& slotOf)
+    {
+        size_t slots = input.size();
+        Array<uint64_t> hashes;
+        hashes.reserve(slots);
+        for (const Entry& entry : input)
+        {
+            hashes.pushBack(hashKey(entry.first, keySeed));
+        }
+
+        // Counting sort of the keys by bucket.
+        Array<uint32_t> bucketStart;
+        bucketStart.resize(buckets + 1);
+        for (uint64_t hash : hashes)
+        {
+            ++bucketStart[bucketFor(hash, buckets) + 1];
+        }
+        for (size_t i = 0; i < buckets; ++i)
+        {
+            bucketStart[i + 1] += bucketStart[i];
+        }
+        Array<uint32_t> members;
+        members.resize(slots);
+        Array<uint32_t> fill;
+        fill.resize(buckets);
+        for (size_t i = 0; i < slots; ++i)
+        {
+            uint32_t bucket = bucketFor(hashes[i], buckets);
+            members[bucketStart[bucket] + fill[bucket]++] = static_cast<uint32_t>(i);
+        }
+
+        Array<uint32_t> order;
+        order.reserve(buckets);
+        for (size_t i = 0; i < buckets; ++i)
+        {
+            order.pushBack(static_cast<uint32_t>(i));
+        }
+        auto bucketSize = [&](uint32_t bucket) {
+            return bucketStart[bucket + 1] - bucketStart[bucket];
+        };
+        std::sort(order.begin(), order.end(),
+                  [&](uint32_t lhs, uint32_t rhs) { return bucketSize(lhs) > bucketSize(rhs); });
+
+        chosen.clear();
+        chosen.resize(buckets);
+        slotOf.clear();
+        slotOf.resize(slots);
+        Array<char> taken;
+        taken.resize(slots);
+        Array<uint32_t> candidate;
+        for (uint32_t bucket : order)
+        {
+            const uint32_t* keys = &members[0] + bucketStart[bucket];
+            size_t size = bucketSize(bucket);
+            if (size == 0)
+            {
+                break;
+            }
+            if (!separable(input, hashes, keys, size))
+            {
+                return false;
+            }
+
+            // Each pilot sends the keys to independent random slots; a singleton bucket placed
+            // when few slots are left needs about slots / free tries.
+            candidate.resize(size);
+            uint32_t pilot = 0;
+            while (!tryPilot(hashes, keys, size, pilot, taken, candidate))
+            {
+                if (++pilot == 0)
+                {
+                    return false;
+                }
+            }
+
+            chosen[bucket] = pilot;
+            for (size_t i = 0; i < size; ++i)
+            {
+                taken[candidate[i]] = 1;
+                slotOf[keys[i]] = candidate[i];
+            }
+        }
+        return true;
+    }
+
+    static bool tryPilot(const Array<uint64_t>& hashes, const uint32_t* keys, size_t size,
+                         uint32_t pilot, const Array<char>& taken, Array<uint32_t>& candidate)
+    {
+        size_t slots = taken.size();
+        for (size_t i = 0; i < size; ++i)
+        {
+            uint32_t slot = slotFor(hashes[keys[i]], pilot, slots);
+            if (taken[slot] || std::find(&candidate[0], &candidate[0] + i, slot) !=
+                                   &candidate[0] + i)
+            {
+                return false;
+            }
+            candidate[i] = slot;
+        }
+        return true;
+    }
+
+    // Two keys of a bucket with the same hash land in the same slot whatever the pilot, so the seed
+    // has to change; if they are the same key, no seed can help. Any duplicate key is found this
+    // way, since equal keys have equal hashes.
+    static bool separable(const Array<Entry>& input, const Array<uint64_t>& hashes,
+                          const uint32_t* keys, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (size_t j = i + 1; j < size; ++j)
+            {
+                if (hashes[keys[i]] != hashes[keys[j]])
+                {
+                    continue;
+                }
+                if (std::memcmp(&input[keys[i]].first, &input[keys[j]].first, sizeof(Key)) == 0)
+                {
+                    throw std::runtime_error("Duplicate key given to FrozenHashMap");
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void attach(const uint64_t* start, size_t size, const std::string& name)
+    {
+        buffer = start;
+        words = size;
+        if (words == 0)
+        {
+            return;
+        }
+
+        const Header* fields = header();
+        if (words * sizeof(uint64_t) < sizeof(Header) || fields->magic != MAGIC)
+        {
+            throw std::runtime_error(name + " is not a FrozenHashMap");
+        }
+        if (fields->version != VERSION || fields->entrySize != sizeof(Entry) ||
+            fields->keySize != sizeof(Key) || fields->valueSize != sizeof(Value))
+        {
+            throw std::runtime_error(name + " was written for other key or value types");
+        }
+        // Every field is checked against the size of the buffer before it is used, with
+        // subtractions and divisions only, so that no corrupt value can overflow a computation.
+        uint64_t totalBytes = words * sizeof(uint64_t);
+        uint64_t entriesOffset = fields->entriesOffset;
+        if (entriesOffset < sizeof(Header) || entriesOffset % alignof(Entry) != 0 ||
+            fields->count > UINT32_MAX || (fields->count > 0 && fields->bucketCount == 0) ||
+            fields->bucketCount > (entriesOffset - sizeof(Header)) / sizeof(uint32_t))
+        {
+            throw std::runtime_error(name + " is corrupt");
+        }
+        if (entriesOffset > totalBytes ||
+            fields->count > (totalBytes - entriesOffset) / sizeof(Entry))
+        {
+            throw std::runtime_error(name + " is truncated");
+        }
+
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(buffer);
+        count = static_cast<size_t>(fields->count);
+        bucketCount = static_cast<size_t>(fields->bucketCount);
+        seed = fields->seed;
+        pilots = reinterpret_cast<const uint32_t*>(bytes + sizeof(Header));
+        entries = reinterpret_cast<const Entry*>(bytes + fields->entriesOffset);
+    }
+};
+
+// Snapshots map into a FrozenHashMap. Keys are compared by their bytes from then on, whatever the
+// KeyEqual of map.
+template <typename Key, typename Value, typename Hasher, typename KeyEqual, typename Stats>
+FrozenHashMap<Key, Value> freeze(const HashMap<Key, Value, Hasher, KeyEqual, Stats>& map)
+{
+    return FrozenHashMap<Key, Value>(map.begin(), map.end());
+}
+} // namespace ds
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace ds
+{
+
+// Hashes a byte range eight bytes at a time. The result only depends on the bytes and the seed, so
+// it is the same for a std::string and a const char* with the same content.
+inline size_t hashBytes(const void* data, size_t length, uint64_t seed = 0)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ seed ^ length;
+    uint64_t word;
+    for (; length >= 8; bytes += 8, length -= 8)
+    {
+        std::memcpy(&word, bytes, 8);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    if (length > 0)
+    {
+        word = 0;
+        std::memcpy(&word, bytes, length);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 29;
+    return static_cast<size_t>(hash);
+}
+
+// Spreads the entropy of a hash over all of its bits with the MurmurHash3 finalizer, so that
+// masking with a power-of-two capacity works even for weak hashes such as the identity std::hash
+// of integers, including keys that only differ above bit 32.
+inline size_t mixHash(size_t hash)
+{
+    uint64_t mixed = static_cast<uint64_t>(hash);
+    mixed ^= mixed >> 33;
+    mixed *= 0xFF51AFD7ED558CCDull;
+    mixed ^= mixed >> 33;
+    mixed *= 0xC4CEB9FE1A85EC53ull;
+    mixed ^= mixed >> 33;
+    return static_cast<size_t>(mixed);
+}
+
+// Default Hasher of the hash maps: std::hash, except for std::string.
+template <typename T>
+struct Hash : std::hash<T>
+{
+};
+
+// Transparent: string literals and string views are hashed in place, without building a
+// temporary std::string.
+template <>
+struct Hash<std::string>
+{
+    using is_transparent = void;
+
+    size_t operator()(const std::string& key) const
+    {
+        return hashBytes(key.data(), key.size());
+    }
+
+    size_t operator()(const char* key) const
+    {
+        return hashBytes(key, std::strlen(key));
+    }
+
+#if __cplusplus >= 201703L
+    size_t operator()(std::string_view key) const
+    {
+        return hashBytes(key.data(), key.size());
+    }
+#endif
+};
+
+// Default KeyEqual of the hash maps. Maps always pass the stored key first.
+template <typename T>
+struct EqualTo : std::equal_to<T>
+{
+};
+
+template <>
+struct EqualTo<std::string>
+{
+    using is_transparent = void;
+
+    bool operator()(const std::string& lhs, const std::string& rhs) const
+    {
+        return lhs == rhs;
+    }
+
+    bool operator()(const std::string& lhs, const char* rhs) const
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+#if __cplusplus >= 201703L
+    bool operator()(const std::string& lhs, std::string_view rhs) const
+    {
+        return lhs == rhs;
+    }
+#endif
+};
+
+template <typename T, typename = void>
+struct IsTransparent : std::false_type
+{
+};
+
+template <typename T>
+struct IsTransparent<T, decltype(static_cast<typename T::is_transparent*>(nullptr), void())>
+    : std::true_type
+{
+};
+} // namespace ds
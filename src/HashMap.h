@@ -1,71 +1,305 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "Array.h"
 #include "DoublyLinkedList.h"
+#include "Hash.h"
+#include "HashMapStats.h"
+#include "ThreadPool.h"
 
 namespace ds
 {
-template <typename Key, typename Value>
+
+// Whether HashMap stores the hash of each key next to its entry. Cached hashes let resize()
+// redistribute entries without calling the hasher, and let lookups skip the key comparison for
+// entries whose hash differs. On by default for keys that are not scalars, e.g. strings, where
+// hashing and comparing are expensive; specialize to opt a key type in or out.
+template <typename Key>
+struct ShouldCacheHash : std::integral_constant<bool, !std::is_scalar<Key>::value>
+{
+};
+
+namespace detail
+{
+
+inline void prefetch(const void* address)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+template <typename ValueType, bool CacheHash>
+struct HashMapEntry;
+
+template <typename ValueType>
+struct HashMapEntry<ValueType, true>
+{
+    template <typename... Args>
+    explicit HashMapEntry(size_t iHash, Args&&... args)
+        : hash(iHash), pair(std::forward<Args>(args)...)
+    {
+    }
+
+    void setHash(size_t newHash)
+    {
+        hash = newHash;
+    }
+
+    template <typename Hasher>
+    size_t hashWith(const Hasher&) const
+    {
+        return hash;
+    }
+
+    bool mayMatch(size_t otherHash) const
+    {
+        return hash == otherHash;
+    }
+
+    size_t hash;
+    ValueType pair;
+};
+
+template <typename ValueType>
+struct HashMapEntry<ValueType, false>
+{
+    template <typename... Args>
+    explicit HashMapEntry(size_t, Args&&... args) : pair(std::forward<Args>(args)...)
+    {
+    }
+
+    void setHash(size_t)
+    {
+    }
+
+    template <typename Hasher>
+    size_t hashWith(const Hasher& hasher) const
+    {
+        return hasher(pair.first);
+    }
+
+    bool mayMatch(size_t) const
+    {
+        return true;
+    }
+
+    ValueType pair;
+};
+} // namespace detail
+
+// When both Hasher and KeyEqual are transparent (define is_transparent), at(), operator[] and
+// erase() also accept any key type they support, e.g. const char* for the default std::string
+// hasher, without converting it to Key first.
+//
+// Stats selects what the map counts for statistics(): NoStats, the default, counts nothing and
+// costs nothing; CountingStats counts lookups, key comparisons and rehashes.
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename KeyEqual = EqualTo<Key>, typename Stats = NoStats>
 class HashMap
 {
+    template <typename K, typename H = Hasher>
+    using EnableIfTransparent =
+        typename std::enable_if<IsTransparent<H>::value && IsTransparent<KeyEqual>::value &&
+                                !std::is_same<K, Key>::value>::type;
+
   public:
     using ValueType = std::pair<const Key, Value>;
+    class Iterator;
+    class ConstIterator;
+
+  private:
+    using Entry = detail::HashMapEntry<ValueType, ShouldCacheHash<Key>::value>;
 
-    HashMap() : capacity(DEFAULT_SIZE), count(0)
+  public:
+    HashMap() : count(0)
     {
+        setBucketCount(DEFAULT_SIZE);
         array.resize(capacity);
     }
 
-    HashMap(const HashMap<Key, Value>& other)
+    explicit HashMap(const Hasher& iHasher, const KeyEqual& iKeyEqual = KeyEqual())
+        : hasher(iHasher), keyEqual(iKeyEqual), count(0)
     {
-        capacity = 0;
-        resize(other.capacity);
-
-        count = other.count;
-
-        for (size_t i = 0; i < capacity; ++i)
-        {
-            array[i] = other.array[i];
-        }
+        setBucketCount(DEFAULT_SIZE);
+        array.resize(capacity);
     }
 
-    HashMap(HashMap<Key, Value>&& other) noexcept
-        : array(std::move(other.array)), capacity(other.capacity), count(other.count)
+    HashMap(const HashMap<Key, Value, Hasher, KeyEqual, Stats>& other) = default;
+
+    HashMap(HashMap<Key, Value, Hasher, KeyEqual, Stats>&& other) noexcept
+        : hasher(other.hasher), keyEqual(other.keyEqual), array(std::move(other.array)),
+          capacity(other.capacity), shift(other.shift), count(other.count),
+          oldArray(std::move(other.oldArray)),
+          oldCapacity(other.oldCapacity), migrated(other.migrated), rehashStep(other.rehashStep),
+          maxLoad(other.maxLoad), stats(other.stats)
     {
+        other.setBucketCount(DEFAULT_SIZE);
         other.array.resize(DEFAULT_SIZE);
         other.count = 0;
+        other.oldCapacity = 0;
     }
 
     ~HashMap() = default;
 
-    HashMap<Key, Value>& operator=(const HashMap<Key, Value>& other)
+    // Builds a map of pairs, an Array of std::pair<Key, Value> or of ValueType, using the threads
+    // of pool. The table is sized once up front, then the pairs are radix partitioned on the top
+    // bits of their bucket index so that every partition owns a contiguous range of buckets, which
+    // one task fills without locks while its slice of the table stays in cache. When a key
+    // appears more than once, the last pair wins, as with insertOrAssign() in order. Hasher and
+    // KeyEqual are called from several threads at once.
+    template <typename Pair, typename Allocator, typename GrowthPolicy>
+    static HashMap<Key, Value, Hasher, KeyEqual, Stats>
+    buildFrom(ThreadPool& pool, const Array<Pair, Allocator, GrowthPolicy>& pairs,
+              const Hasher& iHasher = Hasher(), const KeyEqual& iKeyEqual = KeyEqual())
     {
-        if (this != &other)
+        HashMap<Key, Value, Hasher, KeyEqual, Stats> map(iHasher, iKeyEqual);
+        map.reserve(pairs.size());
+        if (pairs.isEmpty())
         {
-            resize(other.capacity);
-            count = other.count;
+            return map;
+        }
 
-            for (size_t i = 0; i < capacity; ++i)
+        unsigned bucketBits = 0;
+        while ((size_t{1} << bucketBits) < map.capacity)
+        {
+            ++bucketBits;
+        }
+        unsigned partitionBits = 0;
+        while (partitionBits < bucketBits &&
+               ((size_t{1} << partitionBits) < pool.size() * 4 ||
+                (map.capacity >> partitionBits) > BUILD_PARTITION_BUCKETS))
+        {
+            ++partitionBits;
+        }
+        const size_t partitions = size_t{1} << partitionBits;
+        const unsigned partitionShift = bucketBits - partitionBits;
+        const size_t chunks = (pairs.size() + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE;
+
+        // Hash every pair and count, per chunk, how many fall in each partition.
+        Array<size_t> hashes;
+        hashes.resize(pairs.size());
+        Array<size_t> offsets;
+        offsets.resize(chunks * partitions);
+        pool.run(chunks, [&](size_t chunk) {
+            size_t* counts = &offsets[chunk * partitions];
+            size_t last = std::min(pairs.size(), (chunk + 1) * BUILD_CHUNK_SIZE);
+            for (size_t i = chunk * BUILD_CHUNK_SIZE; i < last; ++i)
             {
-                array[i] = other.array[i];
+                hashes[i] = map.hasher(pairs[i].first);
+                ++counts[indexFor(hashes[i], map.shift) >> partitionShift];
+            }
+        });
+
+        // Turn the counts into the position where each chunk writes into each partition; chunks
+        // write in order, so every partition lists its pairs in input order.
+        Array<size_t> partitionStarts;
+        partitionStarts.resize(partitions + 1);
+        size_t position = 0;
+        for (size_t partition = 0; partition < partitions; ++partition)
+        {
+            partitionStarts[partition] = position;
+            for (size_t chunk = 0; chunk < chunks; ++chunk)
+            {
+                size_t chunkCount = offsets[chunk * partitions + partition];
+                offsets[chunk * partitions + partition] = position;
+                position += chunkCount;
             }
         }
+        partitionStarts[partitions] = position;
 
-        return *this;
+        // The hash travels with the index so a partition reads its own slice sequentially.
+        Array<std::pair<size_t, size_t>> order;
+        order.resize(pairs.size());
+        pool.run(chunks, [&](size_t chunk) {
+            size_t* next = &offsets[chunk * partitions];
+            size_t last = std::min(pairs.size(), (chunk + 1) * BUILD_CHUNK_SIZE);
+            for (size_t i = chunk * BUILD_CHUNK_SIZE; i < last; ++i)
+            {
+                size_t partition = indexFor(hashes[i], map.shift) >> partitionShift;
+                order[next[partition]++] = std::pair<size_t, size_t>(hashes[i], i);
+            }
+        });
+
+        // Partitions touch disjoint buckets. Stats hooks are skipped: they are not thread-safe.
+        Array<size_t> inserted;
+        inserted.resize(partitions);
+        pool.run(partitions, [&](size_t partition) {
+            size_t added = 0;
+            size_t end = partitionStarts[partition + 1];
+            for (size_t k = partitionStarts[partition]; k < end; ++k)
+            {
+                // Only the pairs are read out of order; fetch them a few iterations early.
+                if (k + FIND_PREFETCH_DISTANCE < end)
+                {
+                    detail::prefetch(&pairs[order[k + FIND_PREFETCH_DISTANCE].second]);
+                }
+                const Pair& pair = pairs[order[k].second];
+                size_t hash = order[k].first;
+                DoublyLinkedList<Entry>& bucket = map.array[indexFor(hash, map.shift)];
+                Entry* existing = nullptr;
+                for (Entry& entry : bucket)
+                {
+                    if (entry.mayMatch(hash) && map.keyEqual(entry.pair.first, pair.first))
+                    {
+                        existing = &entry;
+                        break;
+                    }
+                }
+                if (existing != nullptr)
+                {
+                    existing->pair.second = pair.second;
+                }
+                else
+                {
+                    bucket.emplaceBack(hash, pair.first, pair.second);
+                    ++added;
+                }
+            }
+            inserted[partition] = added;
+        });
+        for (size_t partition = 0; partition < partitions; ++partition)
+        {
+            map.count += inserted[partition];
+        }
+        return map;
     }
 
-    HashMap<Key, Value>& operator=(HashMap<Key, Value>&& other) noexcept
+    HashMap<Key, Value, Hasher, KeyEqual, Stats>&
+    operator=(const HashMap<Key, Value, Hasher, KeyEqual, Stats>& other) = default;
+
+    HashMap<Key, Value, Hasher, KeyEqual, Stats>&
+    operator=(HashMap<Key, Value, Hasher, KeyEqual, Stats>&& other) noexcept
     {
         if (this != &other)
         {
+            hasher = other.hasher;
+            keyEqual = other.keyEqual;
             array = std::move(other.array);
             capacity = other.capacity;
+            shift = other.shift;
             count = other.count;
+            oldArray = std::move(other.oldArray);
+            oldCapacity = other.oldCapacity;
+            migrated = other.migrated;
+            rehashStep = other.rehashStep;
+            maxLoad = other.maxLoad;
+            stats = other.stats;
 
-            other.resize(DEFAULT_SIZE);
+            other.setBucketCount(DEFAULT_SIZE);
+            other.array.resize(DEFAULT_SIZE);
             other.count = 0;
+            other.oldCapacity = 0;
         }
 
         return *this;
@@ -83,128 +317,824 @@ class HashMap
 
     Value& at(const Key& key) const
     {
-        size_t index = computeIndex(key);
-        DoublyLinkedList<ValueType>& bucket = array[index];
+        return atImpl(key);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    Value& at(const K& key) const
+    {
+        return atImpl(key);
+    }
+
+    // Returns the entry with the given key, or nullptr if there is none. Unlike at(), a miss costs
+    // no more than a hit.
+    ValueType* find(const Key& key) const
+    {
+        return findImpl(key);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    ValueType* find(const K& key) const
+    {
+        return findImpl(key);
+    }
+
+    bool contains(const Key& key) const
+    {
+        return findImpl(key) != nullptr;
+    }
+
+    // Batched find(): stores in results[i] the entry with keys[i], or nullptr. The loop is software
+    // pipelined: the bucket of a key is prefetched FIND_PREFETCH_DISTANCE keys ahead and its first
+    // node half that distance ahead, so the cache misses of many keys overlap instead of being paid
+    // one after the other. Like find(), it only accepts keys of another type than Key when Hasher
+    // and KeyEqual are transparent.
+    void findMany(const Key* keys, size_t n, ValueType** results) const
+    {
+        findManyImpl(keys, n, results);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    void findMany(const K* keys, size_t n, ValueType** results) const
+    {
+        findManyImpl(keys, n, results);
+    }
+
+    Value& operator[](const Key& key)
+    {
+        return tryEmplace(key).first.second;
+    }
+
+    Value& operator[](Key&& key)
+    {
+        return tryEmplace(std::move(key)).first.second;
+    }
+
+    // The key is only converted to Key when it has to be inserted.
+    template <typename K, typename = EnableIfTransparent<K>>
+    Value& operator[](const K& key)
+    {
+        return subscriptImpl(key);
+    }
+
+    void clear()
+    {
+        for (auto it = array.begin(); it != array.end(); ++it)
+        {
+            it->clear();
+        }
+        Array<DoublyLinkedList<Entry>>().swap(oldArray);
+        oldCapacity = 0;
+        // Constructs the buckets an interrupted migration had not reached.
+        array.resize(capacity);
 
-        if (bucket.isEmpty())
+        count = 0;
+    }
+
+    ValueType& insert(const ValueType& pair)
+    {
+        size_t hash = hasher(pair.first);
+        if (findEntry(hash, pair.first) != nullptr)
         {
-            throw std::out_of_range("No value associated to the given key in HashMap");
+            throw std::runtime_error("A value associated to this key already exists in HashMap");
         }
 
-        for (auto it = bucket.begin(); it != bucket.end(); ++it)
+        return insertNew(hash, pair);
+    }
+
+    // Inserts a pair constructed from args unless its key is already present. Returns the entry
+    // with that key and whether it was inserted. The pair is built directly in its list node, which
+    // is linked into the table without being copied or moved.
+    template <typename... Args>
+    std::pair<ValueType&, bool> emplace(Args&&... args)
+    {
+        DoublyLinkedList<Entry> staging;
+        Entry& entry = staging.emplaceBack(0, std::forward<Args>(args)...);
+        size_t hash = hasher(entry.pair.first);
+        Entry* existing = findEntry(hash, entry.pair.first);
+        if (existing != nullptr)
         {
-            if (it->first == key)
-            {
-                return it->second;
-            }
+            return std::pair<ValueType&, bool>(existing->pair, false);
         }
 
-        throw std::runtime_error("No value associated to the given key in HashMap");
+        entry.setHash(hash);
+        prepareInsert();
+        DoublyLinkedList<Entry>& bucket = bucketFor(hash);
+        bucket.splice(bucket.end(), staging, staging.begin());
+        ++count;
+        return std::pair<ValueType&, bool>(entry.pair, true);
     }
 
-    Value& operator[](const Key& key)
+    // Like emplace(), but args only construct the value, and nothing is constructed or moved from
+    // when the key is already present.
+    template <typename... Args>
+    std::pair<ValueType&, bool> tryEmplace(const Key& key, Args&&... args)
+    {
+        return tryEmplaceImpl(hasher(key), key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<ValueType&, bool> tryEmplace(Key&& key, Args&&... args)
+    {
+        size_t hash = hasher(key);
+        return tryEmplaceImpl(hash, std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Inserts the pair or assigns value to the existing entry. Returns the entry and whether it was
+    // inserted.
+    template <typename V>
+    std::pair<ValueType&, bool> insertOrAssign(const Key& key, V&& value)
+    {
+        return insertOrAssignImpl(hasher(key), key, std::forward<V>(value));
+    }
+
+    template <typename V>
+    std::pair<ValueType&, bool> insertOrAssign(Key&& key, V&& value)
+    {
+        size_t hash = hasher(key);
+        return insertOrAssignImpl(hash, std::move(key), std::forward<V>(value));
+    }
+
+    void erase(const Key& key)
+    {
+        eraseImpl(hasher(key), key);
+    }
+
+    template <typename K, typename = EnableIfTransparent<K>>
+    void erase(const K& key)
+    {
+        eraseImpl(hasher(key), key);
+    }
+
+    // Variants of find(), tryEmplace(), insertOrAssign() and erase() for callers that already
+    // computed hash = hasher(key), e.g. to pick a shard, so that the key is not hashed twice. A
+    // hash that does not match the key corrupts the table.
+    ValueType* findHashed(size_t hash, const Key& key) const
+    {
+        Entry* entry = findEntry(hash, key);
+        return entry != nullptr ? &entry->pair : nullptr;
+    }
+
+    template <typename... Args>
+    std::pair<ValueType&, bool> tryEmplaceHashed(size_t hash, const Key& key, Args&&... args)
+    {
+        return tryEmplaceImpl(hash, key, std::forward<Args>(args)...);
+    }
+
+    template <typename V>
+    std::pair<ValueType&, bool> insertOrAssignHashed(size_t hash, const Key& key, V&& value)
+    {
+        return insertOrAssignImpl(hash, key, std::forward<V>(value));
+    }
+
+    // Returns true if the key was present.
+    bool eraseHashed(size_t hash, const Key& key)
+    {
+        return eraseImpl(hash, key);
+    }
+
+    // Capacities are rounded up to a power of two. Only ever grows the table; see rehash() to also
+    // shrink it.
+    void resize(const size_t newCapacity)
     {
-        size_t index = computeIndex(key);
-        DoublyLinkedList<ValueType>& bucket = array[index];
+        finishRehash();
+        if (newCapacity > capacity)
+        {
+            rebuild(roundUp(newCapacity));
+        }
+    }
+
+    // Sizes the table so that expectedCount entries fit without it growing again, e.g. before a
+    // bulk load.
+    void reserve(size_t expectedCount)
+    {
+        resize(capacityFor(expectedCount));
+    }
+
+    // Rebuilds the table with at least bucketCount buckets, or fewer if the current entries fit in
+    // fewer without exceeding the maximum load factor. Can shrink the table.
+    void rehash(size_t newBucketCount)
+    {
+        finishRehash();
+        size_t rounded = roundUp(newBucketCount);
+        size_t required = capacityFor(count);
+        rebuild(rounded > required ? rounded : required);
+    }
+
+    // Returns the memory of buckets left empty by erasures.
+    void shrinkToFit()
+    {
+        rehash(0);
+    }
+
+    size_t bucketCount() const
+    {
+        return capacity;
+    }
 
-        for (ValueType& pair : bucket)
+    float loadFactor() const
+    {
+        return static_cast<float>(count) / capacity;
+    }
+
+    float maxLoadFactor() const
+    {
+        return maxLoad;
+    }
+
+    // Scans the whole table to measure its chain lengths, so it costs O(bucketCount()).
+    HashTableStats statistics() const
+    {
+        HashTableStats table;
+        table.size = count;
+        table.bucketCount = capacity;
+        table.loadFactor = loadFactor();
+        table.memoryBytes = sizeof(*this) +
+                            (array.capacity() + oldArray.capacity()) *
+                                sizeof(DoublyLinkedList<Entry>) +
+                            count * DoublyLinkedList<Entry>::nodeSize();
+        for (size_t i = 0; i < iteratedBucketCount(); ++i)
         {
-            if (pair.first == key)
+            size_t length = 0;
+            for (auto it = bucketAt(i).begin(); it != bucketAt(i).end(); ++it)
+            {
+                ++length;
+            }
+            if (length >= table.chainLengths.size())
             {
-                return pair.second;
+                table.chainLengths.resize(length + 1);
             }
+            ++table.chainLengths[length];
         }
+        stats.report(table);
+        return table;
+    }
 
-        ValueType& value = insert(std::pair<Key, Value>(key, Value{}));
-        return value.second;
+    // The table grows once an insertion would bring the load factor to maxLoadFactor. Rehashes
+    // right away if the current load is already above it. Throws std::runtime_error below 0.01,
+    // where a table would need over a hundred buckets per entry.
+    void setMaxLoadFactor(float newMaxLoadFactor)
+    {
+        if (!(newMaxLoadFactor >= 0.01f))
+        {
+            throw std::runtime_error("HashMap's maximum load factor must be at least 0.01");
+        }
+
+        maxLoad = newMaxLoadFactor;
+        if (capacityFor(count) > capacity)
+        {
+            rehash(0);
+        }
     }
 
-    void clear()
+    // In incremental mode, growing the table only allocates the new bucket array. Entries are then
+    // migrated bucketsPerStep buckets at a time by each insertion or erasure, like Redis's
+    // progressive rehash, and the new buckets are constructed as the migration reaches them, so no
+    // single operation pays for the whole table. A lookup still reads a single bucket: the new one
+    // once it is constructed, else the old one it splits from.
+    void setIncrementalRehash(bool enabled, size_t bucketsPerStep = DEFAULT_REHASH_STEP)
     {
-        for (auto it = array.begin(); it != array.end(); ++it)
+        rehashStep = enabled ? (bucketsPerStep == 0 ? 1 : bucketsPerStep) : 0;
+        if (!enabled)
         {
-            it->clear();
+            finishRehash();
         }
+    }
 
-        count = 0;
+    bool isRehashing() const
+    {
+        return oldCapacity != 0;
     }
 
-    ValueType& insert(const ValueType& pair)
+    // Iterators visit the entries in no particular order and are invalidated by any insertion or
+    // erasure, which may move entries between buckets.
+    Iterator begin()
+    {
+        return Iterator(this, 0, bucketAt(0).begin());
+    }
+
+    Iterator end()
+    {
+        return Iterator(this, iteratedBucketCount(), bucketAt(0).end());
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(Iterator(this, 0, bucketAt(0).begin()));
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(Iterator(this, iteratedBucketCount(), bucketAt(0).end()));
+    }
+
+    ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const
+    {
+        return end();
+    }
+
+  private:
+    constexpr static size_t DEFAULT_SIZE = 256;
+    constexpr static size_t DEFAULT_REHASH_STEP = 64;
+    constexpr static size_t FIND_PREFETCH_DISTANCE = 16;
+    constexpr static size_t MIN_SIZE = 8;
+    // buildFrom() hashes and scatters pairs in chunks of this many, and partitions the table into
+    // slices of at most this many buckets.
+    constexpr static size_t BUILD_CHUNK_SIZE = 64 * 1024;
+    constexpr static size_t BUILD_PARTITION_BUCKETS = 16 * 1024;
+    Hasher hasher;
+    KeyEqual keyEqual;
+    // While a migration is in progress, only the first 2 * migrated buckets are constructed.
+    Array<DoublyLinkedList<Entry>> array;
+    size_t capacity = 0;
+    // How far the mixed hash is shifted right to index a bucket: the word size minus
+    // log2(capacity).
+    unsigned shift = 0;
+    size_t count = 0;
+    // Table being drained by an incremental rehash; its buckets below migrated are empty. Once
+    // every bucket is migrated, the empty buckets are destroyed a step at a time as well.
+    Array<DoublyLinkedList<Entry>> oldArray;
+    // Bucket count of the old table while a migration is in progress, otherwise 0.
+    size_t oldCapacity = 0;
+    size_t migrated = 0;
+    // Buckets migrated per operation; 0 when incremental rehashing is off.
+    size_t rehashStep = 0;
+    float maxLoad = 0.75f;
+    mutable Stats stats;
+
+    // Throws std::length_error instead of letting the bucket count overflow.
+    static size_t doubled(size_t bucketCount)
+    {
+        if (bucketCount > SIZE_MAX / 2)
+        {
+            throw std::length_error("HashMap cannot have that many buckets");
+        }
+        return bucketCount * 2;
+    }
+
+    static size_t roundUp(size_t bucketCount)
     {
-        if ((static_cast<float>(count + 1) / capacity) >= maxLoadFactor)
+        size_t rounded = MIN_SIZE;
+        while (rounded < bucketCount)
         {
-            resize(capacity * 2);
+            rounded = doubled(rounded);
         }
+        return rounded;
+    }
 
-        size_t index = computeIndex(pair.first);
-        DoublyLinkedList<ValueType>& bucket = array[index];
+    // Smallest table in which entryCount entries stay below the maximum load factor.
+    size_t capacityFor(size_t entryCount) const
+    {
+        size_t rounded = MIN_SIZE;
+        while (static_cast<float>(entryCount) / rounded >= maxLoad)
+        {
+            rounded = doubled(rounded);
+        }
+        return rounded;
+    }
 
-        for (auto it = bucket.begin(); it != bucket.end(); ++it)
+    // Moves every entry into a new table of newCapacity buckets; no incremental rehash may be in
+    // progress.
+    void rebuild(size_t newCapacity)
+    {
+        if (newCapacity == capacity)
+        {
+            return;
+        }
+
+        stats.countRehash();
+        typename Stats::Timer timer(stats);
+        Array<DoublyLinkedList<Entry>> previous{};
+        previous.swap(array);
+
+        setBucketCount(newCapacity);
+        array.resize(newCapacity);
+
+        for (DoublyLinkedList<Entry>& bucket : previous)
+        {
+            moveBucket(bucket);
+        }
+    }
+
+    void setBucketCount(size_t newCapacity)
+    {
+        capacity = newCapacity;
+        shift = sizeof(size_t) * 8;
+        for (size_t i = newCapacity; i > 1; i /= 2)
+        {
+            --shift;
+        }
+    }
+
+    // Top bits rather than low bits, so that doubling the table splits bucket i into buckets 2i
+    // and 2i + 1, and the new table can be constructed front to back as the old one is migrated.
+    static size_t indexFor(size_t hash, unsigned tableShift)
+    {
+        return mixHash(hash) >> tableShift;
+    }
+
+    // The bucket that holds hash. During a migration, the entries of a new bucket that is not
+    // constructed yet are still in the old bucket it splits from.
+    DoublyLinkedList<Entry>& bucketFor(size_t hash) const
+    {
+        size_t index = indexFor(hash, shift);
+        return index < array.size() ? array[index] : oldArray[index >> 1];
+    }
+
+    // Iterators number the constructed buckets of the current table first, then those of the old
+    // one.
+    size_t iteratedBucketCount() const
+    {
+        return array.size() + oldArray.size();
+    }
+
+    DoublyLinkedList<Entry>& bucketAt(size_t index) const
+    {
+        return index < array.size() ? array[index] : oldArray[index - array.size()];
+    }
+
+    template <typename K>
+    Entry* findIn(DoublyLinkedList<Entry>& bucket, size_t hash, const K& key) const
+    {
+        for (Entry& entry : bucket)
         {
-            if (it->first == pair.first)
+            if (entry.mayMatch(hash))
             {
-                throw std::runtime_error(
-                    "A value associated to this key already exists in HashMap");
+                stats.countComparison();
+                if (keyEqual(entry.pair.first, key))
+                {
+                    return &entry;
+                }
             }
         }
 
-        array[index].pushBack(pair);
+        return nullptr;
+    }
+
+    template <typename K>
+    Entry* findEntry(size_t hash, const K& key) const
+    {
+        stats.countLookup();
+        return findIn(bucketFor(hash), hash, key);
+    }
+
+    // Makes room for one more entry; bucket references are invalid afterwards.
+    void prepareInsert()
+    {
+        stepRehash();
+        if ((static_cast<float>(count + 1) / capacity) >= maxLoad)
+        {
+            grow();
+        }
+    }
+
+    // Adds an entry whose key is known to be absent, constructing the pair from args in place.
+    template <typename... Args>
+    ValueType& insertNew(size_t hash, Args&&... args)
+    {
+        prepareInsert();
+        Entry& entry = bucketFor(hash).emplaceBack(hash, std::forward<Args>(args)...);
         ++count;
 
-        return array[index].getBack();
+        return entry.pair;
     }
 
-    void erase(const Key& key)
+    template <typename K, typename... Args>
+    std::pair<ValueType&, bool> tryEmplaceImpl(size_t hash, K&& key, Args&&... args)
     {
-        size_t index = computeIndex(key);
-        DoublyLinkedList<ValueType>& bucket = array[index];
+        Entry* existing = findEntry(hash, key);
+        if (existing != nullptr)
+        {
+            return std::pair<ValueType&, bool>(existing->pair, false);
+        }
 
-        for (auto it = bucket.begin(); it != bucket.end(); ++it)
+        ValueType& pair = insertNew(hash, std::piecewise_construct,
+                                    std::forward_as_tuple(std::forward<K>(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+        return std::pair<ValueType&, bool>(pair, true);
+    }
+
+    template <typename K, typename V>
+    std::pair<ValueType&, bool> insertOrAssignImpl(size_t hash, K&& key, V&& value)
+    {
+        Entry* existing = findEntry(hash, key);
+        if (existing != nullptr)
         {
-            if (it->first == key)
+            existing->pair.second = std::forward<V>(value);
+            return std::pair<ValueType&, bool>(existing->pair, false);
+        }
+
+        ValueType& pair = insertNew(hash, std::forward<K>(key), std::forward<V>(value));
+        return std::pair<ValueType&, bool>(pair, true);
+    }
+
+    void grow()
+    {
+        if (rehashStep == 0)
+        {
+            resize(doubled(capacity));
+            return;
+        }
+
+        size_t newCapacity = doubled(capacity);
+        finishRehash();
+        stats.countRehash();
+        oldArray.swap(array);
+        oldCapacity = capacity;
+        migrated = 0;
+
+        // Only allocated: the buckets are constructed as the migration reaches them.
+        setBucketCount(newCapacity);
+        array.reserve(capacity);
+    }
+
+    // Relinks the nodes of bucket into the current table; no entry is copied.
+    void moveBucket(DoublyLinkedList<Entry>& bucket)
+    {
+        while (!bucket.isEmpty())
+        {
+            auto it = bucket.begin();
+            DoublyLinkedList<Entry>& target = array[indexFor(it->hashWith(hasher), shift)];
+            target.splice(target.end(), bucket, it);
+        }
+    }
+
+    // Constructs the two buckets old bucket i splits into, then moves its entries there.
+    void migrateBucket(size_t i)
+    {
+        array.emplaceBack();
+        array.emplaceBack();
+        moveBucket(oldArray[i]);
+    }
+
+    // Migrates up to rehashStep non-empty buckets, visiting at most ten times as many empty ones.
+    // After the last one, each step destroys that many empty old buckets until none is left.
+    void stepRehash()
+    {
+        if (oldArray.isEmpty())
+        {
+            return;
+        }
+
+        typename Stats::Timer timer(stats);
+        size_t visitLimit = rehashStep * 10;
+        if (isRehashing())
+        {
+            size_t moved = 0;
+            visitLimit += migrated;
+            for (; migrated < oldCapacity && moved < rehashStep && migrated < visitLimit;
+                 ++migrated)
             {
-                bucket.erase(it);
-                --count;
-                return;
+                if (!oldArray[migrated].isEmpty())
+                {
+                    ++moved;
+                }
+                migrateBucket(migrated);
             }
+            if (migrated == oldCapacity)
+            {
+                oldCapacity = 0;
+            }
+            return;
+        }
+
+        for (size_t destroyed = 0; destroyed < visitLimit && !oldArray.isEmpty(); ++destroyed)
+        {
+            oldArray.popBack();
+        }
+        if (oldArray.isEmpty())
+        {
+            Array<DoublyLinkedList<Entry>>().swap(oldArray);
         }
     }
 
-    void resize(const size_t newCapacity)
+    void finishRehash()
     {
-        if (newCapacity <= capacity)
+        if (oldArray.isEmpty())
         {
             return;
         }
 
-        Array<DoublyLinkedList<ValueType>> oldArray{};
-        oldArray.swap(array);
+        typename Stats::Timer timer(stats);
+        for (; migrated < oldCapacity; ++migrated)
+        {
+            migrateBucket(migrated);
+        }
+        Array<DoublyLinkedList<Entry>>().swap(oldArray);
+        oldCapacity = 0;
+    }
 
-        array.resize(newCapacity);
-        capacity = newCapacity;
-        count = 0;
+    template <typename K>
+    Value& atImpl(const K& key) const
+    {
+        Entry* entry = findEntry(hasher(key), key);
+        if (entry == nullptr)
+        {
+            throw std::out_of_range("No value associated to the given key in HashMap");
+        }
 
-        for (DoublyLinkedList<ValueType>& bucket : oldArray)
+        return entry->pair.second;
+    }
+
+    template <typename K>
+    ValueType* findImpl(const K& key) const
+    {
+        Entry* entry = findEntry(hasher(key), key);
+        return entry != nullptr ? &entry->pair : nullptr;
+    }
+
+    template <typename K>
+    void findManyImpl(const K* keys, size_t n, ValueType** results) const
+    {
+        const size_t nodeDistance = FIND_PREFETCH_DISTANCE / 2;
+        size_t hashes[FIND_PREFETCH_DISTANCE];
+        for (size_t i = 0; i < n + FIND_PREFETCH_DISTANCE; ++i)
         {
-            for (ValueType& pair : bucket)
+            if (i >= FIND_PREFETCH_DISTANCE)
             {
-                size_t index = computeIndex(pair.first);
-                array[index].pushBack(pair);
-                ++count;
+                size_t index = i - FIND_PREFETCH_DISTANCE;
+                Entry* entry = findEntry(hashes[index % FIND_PREFETCH_DISTANCE], keys[index]);
+                results[index] = entry != nullptr ? &entry->pair : nullptr;
+            }
+            if (i >= nodeDistance && i - nodeDistance < n)
+            {
+                DoublyLinkedList<Entry>& bucket =
+                    bucketFor(hashes[(i - nodeDistance) % FIND_PREFETCH_DISTANCE]);
+                if (!bucket.isEmpty())
+                {
+                    detail::prefetch(&*bucket.begin());
+                }
+            }
+            if (i < n)
+            {
+                size_t hash = hasher(keys[i]);
+                hashes[i % FIND_PREFETCH_DISTANCE] = hash;
+                detail::prefetch(&bucketFor(hash));
             }
         }
     }
 
+    template <typename K>
+    Value& subscriptImpl(const K& key)
+    {
+        size_t hash = hasher(key);
+        Entry* entry = findEntry(hash, key);
+        if (entry != nullptr)
+        {
+            return entry->pair.second;
+        }
+
+        ValueType& pair = insertNew(hash, std::piecewise_construct,
+                                    std::forward_as_tuple(key), std::forward_as_tuple());
+        return pair.second;
+    }
+
+    template <typename K>
+    bool eraseFrom(DoublyLinkedList<Entry>& bucket, size_t hash, const K& key)
+    {
+        for (auto it = bucket.begin(); it != bucket.end(); ++it)
+        {
+            if (!it->mayMatch(hash))
+            {
+                continue;
+            }
+            stats.countComparison();
+            if (keyEqual(it->pair.first, key))
+            {
+                bucket.erase(it);
+                --count;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename K>
+    bool eraseImpl(size_t hash, const K& key)
+    {
+        stepRehash();
+        stats.countLookup();
+        return eraseFrom(bucketFor(hash), hash, key);
+    }
+};
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual, typename Stats>
+class HashMap<Key, Value, Hasher, KeyEqual, Stats>::Iterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType*;
+    using reference = ValueType&;
+
+    reference operator*() const
+    {
+        return current->pair;
+    }
+    pointer operator->() const
+    {
+        return &current->pair;
+    }
+    bool operator==(const Iterator& other) const
+    {
+        return current == other.current;
+    }
+    bool operator!=(const Iterator& other) const
+    {
+        return current != other.current;
+    }
+    Iterator& operator++()
+    {
+        ++current;
+        skipEmptyBuckets();
+        return *this;
+    }
+    Iterator operator++(int)
+    {
+        Iterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
   private:
-    constexpr static size_t DEFAULT_SIZE = 256;
-    constexpr static float maxLoadFactor = 0.75;
-    Array<DoublyLinkedList<ValueType>> array;
-    size_t capacity = 0;
-    size_t count = 0;
+    using ListIterator = typename DoublyLinkedList<Entry>::Iterator;
 
-    size_t computeIndex(const Key& key) const
+    Iterator(const HashMap* iMap, size_t iBucket, ListIterator iCurrent)
+        : map(iMap), bucket(iBucket), current(iCurrent)
     {
-        return (std::hash<Key>{}(key) % capacity);
+        skipEmptyBuckets();
+    }
+
+    // Moves to the first entry at or after the current position; past the last bucket, current is
+    // the end iterator of a list, which compares equal to any other.
+    void skipEmptyBuckets()
+    {
+        while (bucket < map->iteratedBucketCount() && current == map->bucketAt(bucket).end())
+        {
+            if (++bucket < map->iteratedBucketCount())
+            {
+                current = map->bucketAt(bucket).begin();
+            }
+        }
     }
+
+    const HashMap* map;
+    size_t bucket;
+    ListIterator current;
+
+    friend class HashMap;
+};
+
+template <typename Key, typename Value, typename Hasher, typename KeyEqual, typename Stats>
+class HashMap<Key, Value, Hasher, KeyEqual, Stats>::ConstIterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ValueType*;
+    using reference = const ValueType&;
+
+    ConstIterator(const Iterator& other) : it(other)
+    {
+    }
+
+    reference operator*() const
+    {
+        return *it;
+    }
+    pointer operator->() const
+    {
+        return &*it;
+    }
+    bool operator==(const ConstIterator& other) const
+    {
+        return it == other.it;
+    }
+    bool operator!=(const ConstIterator& other) const
+    {
+        return it != other.it;
+    }
+    ConstIterator& operator++()
+    {
+        ++it;
+        return *this;
+    }
+    ConstIterator operator++(int)
+    {
+        ConstIterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
+  private:
+    Iterator it;
 };
-} // namespace ds
\ No newline at end of file
+} // namespace ds
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Array.h"
+
+namespace ds
+{
+
+// Snapshot returned by statistics() of HashMap and FlatHashMap. The shape of the table is measured
+// when statistics() is called; the counters are only kept by maps using the CountingStats policy
+// and are zero otherwise.
+struct HashTableStats
+{
+    size_t size = 0;
+    size_t bucketCount = 0;
+    float loadFactor = 0;
+    // HashMap: chainLengths[n] is the number of buckets holding n entries.
+    Array<size_t> chainLengths;
+    // FlatHashMap: probeDistances[n] is the number of entries n slots away from their home slot,
+    // i.e. found after n + 1 probes.
+    Array<size_t> probeDistances;
+    // Bytes held by the map, its buckets and its nodes; memory owned by the keys and values
+    // themselves, e.g. the characters of long strings, is not included.
+    size_t memoryBytes = 0;
+
+    // Every key search, including those made by insertions and erasures.
+    uint64_t lookups = 0;
+    // Calls to KeyEqual made by those searches.
+    uint64_t keyComparisons = 0;
+    // Times the table was rebuilt or started an incremental rehash, and the time spent moving
+    // entries to a new table.
+    uint64_t rehashes = 0;
+    double rehashMilliseconds = 0;
+
+    double comparisonsPerLookup() const
+    {
+        return lookups == 0 ? 0 : static_cast<double>(keyComparisons) / lookups;
+    }
+};
+
+// Default statistics policy of the hash maps: every hook is empty and compiles away.
+struct NoStats
+{
+    struct Timer
+    {
+        explicit Timer(NoStats&)
+        {
+        }
+    };
+
+    void countLookup()
+    {
+    }
+
+    void countComparison()
+    {
+    }
+
+    void countRehash()
+    {
+    }
+
+    void report(HashTableStats&) const
+    {
+    }
+};
+
+// Statistics policy that counts lookups, key comparisons and rehashes with plain integers, cheap
+// enough to leave on. The counters are not atomic: like the map itself, a map using this policy
+// must not be read from several threads at once.
+struct CountingStats
+{
+    // Adds the time between its construction and destruction to the rehash time.
+    struct Timer
+    {
+        explicit Timer(CountingStats& iStats)
+            : stats(iStats), start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~Timer()
+        {
+            stats.rehashTime += std::chrono::steady_clock::now() - start;
+        }
+
+        CountingStats& stats;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void countLookup()
+    {
+        ++lookups;
+    }
+
+    void countComparison()
+    {
+        ++keyComparisons;
+    }
+
+    void countRehash()
+    {
+        ++rehashes;
+    }
+
+    void report(HashTableStats& table) const
+    {
+        table.lookups = lookups;
+        table.keyComparisons = keyComparisons;
+        table.rehashes = rehashes;
+        table.rehashMilliseconds =
+            std::chrono::duration<double, std::milli>(rehashTime).count();
+    }
+
+    uint64_t lookups = 0;
+    uint64_t keyComparisons = 0;
+    uint64_t rehashes = 0;
+    std::chrono::steady_clock::duration rehashTime{};
+};
+} // namespace ds
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "Array.h"
+#include "FlatHashMap.h"
+#include "Hash.h"
+
+namespace ds
+{
+
+// Cost policy of LruCache bounding it by entry count: every entry costs 1.
+struct UnitCost
+{
+    template <typename Key, typename Value>
+    size_t operator()(const Key&, const Value&) const
+    {
+        return 1;
+    }
+};
+
+// Least-recently-used cache holding entries whose total cost stays within a capacity. Cost is a
+// function of the key and value, so the capacity counts entries with the default UnitCost or bytes
+// with a functor returning the size of each entry. Entries live in one slab array and are linked
+// into the recency list by index, so an entry costs no allocation of its own. Keys are stored in
+// the slab only: a FlatHashMap indexes slab positions together with the hash of their key, and
+// looks keys up by comparing against the slab. get, put and erase are O(1).
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename KeyEqual = EqualTo<Key>, typename Cost = UnitCost>
+class LruCache
+{
+  public:
+    // Throws std::runtime_error if capacity is 0.
+    explicit LruCache(size_t iCapacity, const Cost& iCost = Cost(),
+                      const Hasher& iHasher = Hasher(), const KeyEqual& iKeyEqual = KeyEqual())
+        : hasher(iHasher), index(NodeRefHash(), NodeRefEqual(&nodes, iKeyEqual)), cost(iCost),
+          maxCost(iCapacity)
+    {
+        if (iCapacity == 0)
+        {
+            throw std::runtime_error("LruCache capacity must be positive");
+        }
+    }
+
+    // The index points into the slab, so a cache can be neither copied nor moved.
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    size_t size() const
+    {
+        return nodes.size();
+    }
+
+    bool isEmpty() const
+    {
+        return nodes.size() == 0;
+    }
+
+    size_t capacity() const
+    {
+        return maxCost;
+    }
+
+    // Sum of the costs of the cached entries.
+    size_t totalCost() const
+    {
+        return usedCost;
+    }
+
+    // Returns the value of key and marks it most recently used, or nullptr if it is not cached.
+    // The pointer is invalidated by the next put or erase.
+    Value* get(const Key& key)
+    {
+        typename Index::ValueType* found = index.find(lookupOf(key));
+        if (found == nullptr)
+        {
+            return nullptr;
+        }
+        moveToFront(found->first.position);
+        return &nodes[found->first.position].value;
+    }
+
+    // Like get, without changing the eviction order.
+    const Value* peek(const Key& key) const
+    {
+        typename Index::ValueType* found = index.find(lookupOf(key));
+        return found == nullptr ? nullptr : &nodes[found->first.position].value;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return index.contains(lookupOf(key));
+    }
+
+    // Stores value under key as the most recently used entry, replacing any previous value, and
+    // evicts least recently used entries until the total cost fits the capacity again. Returns
+    // false, leaving key uncached, if the entry alone costs more than the capacity.
+    bool put(const Key& key, Value value)
+    {
+        size_t entryCost = cost(key, value);
+        KeyLookup lookup = lookupOf(key);
+        typename Index::ValueType* found = index.find(lookup);
+        if (entryCost > maxCost)
+        {
+            if (found != nullptr)
+            {
+                remove(found->first.position);
+            }
+            return false;
+        }
+
+        if (found != nullptr)
+        {
+            size_t position = found->first.position;
+            Node& node = nodes[position];
+            usedCost = usedCost - node.cost + entryCost;
+            node.value = std::move(value);
+            node.cost = entryCost;
+            moveToFront(position);
+            evictOver(maxCost, position);
+            return true;
+        }
+
+        // When full, the least recently used node is recycled in place for the new entry, which
+        // saves moving the last node of the slab into the hole an eviction would leave.
+        if (tail != NIL && usedCost + entryCost > maxCost)
+        {
+            size_t position = tail;
+            Node& node = nodes[position];
+            index.erase(NodeRef{position, node.hash});
+            usedCost -= node.cost;
+            node.key = key;
+            node.hash = lookup.hash;
+            node.value = std::move(value);
+            node.cost = entryCost;
+            usedCost += entryCost;
+            index[NodeRef{position, lookup.hash}] = true;
+            moveToFront(position);
+            evictOver(maxCost, position);
+            return true;
+        }
+
+        nodes.emplaceBack(key, lookup.hash, std::move(value), entryCost);
+        size_t position = nodes.size() - 1;
+        linkFront(position);
+        usedCost += entryCost;
+        index[NodeRef{position, lookup.hash}] = true;
+        return true;
+    }
+
+    // Returns true if the key was cached.
+    bool erase(const Key& key)
+    {
+        typename Index::ValueType* found = index.find(lookupOf(key));
+        if (found == nullptr)
+        {
+            return false;
+        }
+        remove(found->first.position);
+        return true;
+    }
+
+    void clear()
+    {
+        nodes.clear();
+        index.clear();
+        head = NIL;
+        tail = NIL;
+        usedCost = 0;
+    }
+
+    // Evicts least recently used entries until the total cost is at most newCapacity, which
+    // becomes the new bound. Throws std::runtime_error if newCapacity is 0.
+    void setCapacity(size_t newCapacity)
+    {
+        if (newCapacity == 0)
+        {
+            throw std::runtime_error("LruCache capacity must be positive");
+        }
+        maxCost = newCapacity;
+        evictOver(maxCost, NIL);
+    }
+
+    // Key of the entry the next eviction would remove. Throws std::runtime_error if empty.
+    const Key& leastRecentKey() const
+    {
+        if (tail == NIL)
+        {
+            throw std::runtime_error("leastRecentKey() method called on an empty LruCache");
+        }
+        return nodes[tail].key;
+    }
+
+  private:
+    constexpr static size_t NIL = SIZE_MAX;
+
+    struct Node
+    {
+        Node(const Key& iKey, size_t iHash, Value&& iValue, size_t iCost)
+            : key(iKey), hash(iHash), value(std::move(iValue)), cost(iCost)
+        {
+        }
+
+        Key key;
+        // Hash of key, so that its index entry is found again without hashing the key.
+        size_t hash;
+        Value value;
+        size_t cost;
+        size_t prev = NIL;
+        size_t next = NIL;
+    };
+
+    // Entry of the index: the slab position of a node and the hash of its key, so that growing the
+    // index never hashes keys again and most mismatches are rejected without comparing keys.
+    struct NodeRef
+    {
+        size_t position;
+        size_t hash;
+    };
+
+    // A key being looked up, hashed once.
+    struct KeyLookup
+    {
+        const Key* key;
+        size_t hash;
+    };
+
+    struct NodeRefHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const NodeRef& ref) const
+        {
+            return ref.hash;
+        }
+
+        size_t operator()(const KeyLookup& lookup) const
+        {
+            return lookup.hash;
+        }
+    };
+
+    // Positions of one index are unique, so two stored refs are equal only if they share one.
+    struct NodeRefEqual
+    {
+        using is_transparent = void;
+
+        NodeRefEqual(const Array<Node>* iNodes, const KeyEqual& iKeyEqual)
+            : nodes(iNodes), keyEqual(iKeyEqual)
+        {
+        }
+
+        bool operator()(const NodeRef& lhs, const NodeRef& rhs) const
+        {
+            return lhs.position == rhs.position;
+        }
+
+        bool operator()(const NodeRef& lhs, const KeyLookup& rhs) const
+        {
+            return lhs.hash == rhs.hash && keyEqual((*nodes)[lhs.position].key, *rhs.key);
+        }
+
+        const Array<Node>* nodes;
+        KeyEqual keyEqual;
+    };
+
+    using Index = FlatHashMap<NodeRef, bool, NodeRefHash, NodeRefEqual>;
+
+    Array<Node> nodes;
+    Hasher hasher;
+    Index index;
+    Cost cost;
+    size_t maxCost;
+    size_t usedCost = 0;
+    // Most and least recently used nodes.
+    size_t head = NIL;
+    size_t tail = NIL;
+
+    KeyLookup lookupOf(const Key& key) const
+    {
+        return KeyLookup{&key, hasher(key)};
+    }
+
+    void linkFront(size_t position)
+    {
+        Node& node = nodes[position];
+        node.prev = NIL;
+        node.next = head;
+        if (head != NIL)
+        {
+            nodes[head].prev = position;
+        }
+        else
+        {
+            tail = position;
+        }
+        head = position;
+    }
+
+    void unlink(size_t position)
+    {
+        Node& node = nodes[position];
+        if (node.prev != NIL)
+        {
+            nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            head = node.next;
+        }
+        if (node.next != NIL)
+        {
+            nodes[node.next].prev = node.prev;
+        }
+        else
+        {
+            tail = node.prev;
+        }
+    }
+
+    void moveToFront(size_t position)
+    {
+        if (position != head)
+        {
+            unlink(position);
+            linkFront(position);
+        }
+    }
+
+    // Evicts from the tail until the total cost is at most limit, never evicting keep.
+    void evictOver(size_t limit, size_t keep)
+    {
+        while (usedCost > limit && tail != NIL && tail != keep)
+        {
+            remove(tail);
+        }
+    }
+
+    // Unlinks and destroys the node at position. The last node of the slab moves into the hole so
+    // the slab stays dense.
+    void remove(size_t position)
+    {
+        unlink(position);
+        index.erase(NodeRef{position, nodes[position].hash});
+        usedCost -= nodes[position].cost;
+
+        size_t last = nodes.size() - 1;
+        if (position != last)
+        {
+            Node& moved = nodes[last];
+            nodes[position] = std::move(moved);
+            if (moved.prev != NIL)
+            {
+                nodes[moved.prev].next = position;
+            }
+            else
+            {
+                head = position;
+            }
+            if (moved.next != NIL)
+            {
+                nodes[moved.next].prev = position;
+            }
+            else
+            {
+                tail = position;
+            }
+            index.erase(NodeRef{last, moved.hash});
+            index[NodeRef{position, moved.hash}] = true;
+        }
+        nodes.popBack();
+    }
+};
+} // namespace ds
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Array.h"
+
+namespace ds
+{
+
+enum class MapMode
+{
+    // Shared read-only mapping; writing to an element is undefined behavior.
+    ReadOnly,
+    // Private mapping: writes stay in this process and never reach the file.
+    CopyOnWrite,
+    // Shared mapping of a file created if missing. The array can grow; the file is truncated to
+    // the element count when the array is destroyed.
+    ReadWrite
+};
+
+// Array of trivially copyable elements backed by a memory-mapped file. Opening is O(1): pages are
+// only read when they are first touched.
+template <typename T>
+class MappedArray
+{
+  public:
+    using Iterator = typename Array<T>::Iterator;
+    using ConstIterator = typename Array<T>::ConstIterator;
+
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MappedArray requires a trivially copyable element type");
+
+    MappedArray(const std::string& path, MapMode iMode = MapMode::ReadOnly) : mode(iMode)
+    {
+        int flags = mode == MapMode::ReadWrite ? O_RDWR | O_CREAT : O_RDONLY;
+        fd = ::open(path.c_str(), flags, 0644);
+        if (fd < 0)
+        {
+            throwSystemError("Cannot open " + path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throwSystemError("Cannot stat " + path);
+        }
+
+        size_t bytes = static_cast<size_t>(info.st_size);
+        if (bytes % sizeof(T) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Size of " + path + " is not a multiple of the element size");
+        }
+
+        count = bytes / sizeof(T);
+        currentCapacity = count;
+        try
+        {
+            array = map(currentCapacity);
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+    }
+
+    MappedArray(const MappedArray<T>&) = delete;
+    MappedArray<T>& operator=(const MappedArray<T>&) = delete;
+
+    MappedArray(MappedArray<T>&& other) noexcept
+        : mode(other.mode), fd(other.fd), array(other.array), count(other.count),
+          currentCapacity(other.currentCapacity)
+    {
+        other.fd = -1;
+        other.array = nullptr;
+        other.count = 0;
+        other.currentCapacity = 0;
+    }
+
+    MappedArray<T>& operator=(MappedArray<T>&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            mode = other.mode;
+            fd = other.fd;
+            array = other.array;
+            count = other.count;
+            currentCapacity = other.currentCapacity;
+            other.fd = -1;
+            other.array = nullptr;
+            other.count = 0;
+            other.currentCapacity = 0;
+        }
+        return *this;
+    }
+
+    ~MappedArray()
+    {
+        close();
+    }
+
+    T& operator[](size_t i) const
+    {
+        return array[i];
+    }
+
+    T& at(size_t i) const
+    {
+        if (i >= count)
+        {
+            throw std::out_of_range("Out of bounds in at() method");
+        }
+        return array[i];
+    }
+
+    T* data() const
+    {
+        return array;
+    }
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    size_t capacity() const
+    {
+        return currentCapacity;
+    }
+
+    MapMode getMode() const
+    {
+        return mode;
+    }
+
+    // Grows the file and the mapping; ReadWrite mode only.
+    void reserve(size_t newCapacity)
+    {
+        if (newCapacity <= currentCapacity)
+        {
+            return;
+        }
+        requireWritable("reserve()");
+
+        if (::ftruncate(fd, static_cast<off_t>(newCapacity * sizeof(T))) != 0)
+        {
+            throwSystemError("Cannot grow mapped file");
+        }
+        array = remap(newCapacity);
+        currentCapacity = newCapacity;
+    }
+
+    void resize(size_t newSize)
+    {
+        if (newSize > count)
+        {
+            reserve(newSize);
+            std::memset(static_cast<void*>(array + count), 0, (newSize - count) * sizeof(T));
+        }
+        else
+        {
+            requireWritable("resize()");
+        }
+        count = newSize;
+    }
+
+    void clear()
+    {
+        requireWritable("clear()");
+        count = 0;
+    }
+
+    void pushBack(const T& data)
+    {
+        requireWritable("pushBack()");
+        if (count == currentCapacity)
+        {
+            T copy = data;
+            reserve(currentCapacity == 0 ? DEFAULT_SIZE : currentCapacity * 2);
+            array[count++] = copy;
+            return;
+        }
+        array[count++] = data;
+    }
+
+    T popBack()
+    {
+        requireWritable("popBack()");
+        if (count == 0)
+        {
+            throw std::runtime_error("Method popBack() called on an empty array");
+        }
+        return array[--count];
+    }
+
+    // Flushes modified pages of a ReadWrite mapping to the file.
+    void sync() const
+    {
+        if (mode == MapMode::ReadWrite && array != nullptr &&
+            ::msync(array, currentCapacity * sizeof(T), MS_SYNC) != 0)
+        {
+            throwSystemError("Cannot sync mapped file");
+        }
+    }
+
+    Iterator begin()
+    {
+        return Iterator(array);
+    }
+
+    Iterator end()
+    {
+        return Iterator(array + count);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(array);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(array + count);
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(array);
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(array + count);
+    }
+
+  private:
+    constexpr static size_t DEFAULT_SIZE = 1024;
+    MapMode mode;
+    int fd = -1;
+    T* array = nullptr;
+    size_t count = 0;
+    size_t currentCapacity = 0;
+
+    [[noreturn]] static void throwSystemError(const std::string& message)
+    {
+        throw std::runtime_error(message + ": " + std::strerror(errno));
+    }
+
+    void requireWritable(const char* method) const
+    {
+        if (mode != MapMode::ReadWrite)
+        {
+            throw std::runtime_error(std::string(method) + " requires a ReadWrite MappedArray");
+        }
+    }
+
+    T* map(size_t n) const
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+
+        int protection = mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        int flags = mode == MapMode::CopyOnWrite ? MAP_PRIVATE : MAP_SHARED;
+        void* address = ::mmap(nullptr, n * sizeof(T), protection, flags, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            throwSystemError("Cannot map file");
+        }
+        return static_cast<T*>(address);
+    }
+
+    T* remap(size_t newCapacity)
+    {
+        if (array == nullptr)
+        {
+            return map(newCapacity);
+        }
+
+#ifdef __linux__
+        void* address = ::mremap(array, currentCapacity * sizeof(T), newCapacity * sizeof(T),
+                                 MREMAP_MAYMOVE);
+        if (address == MAP_FAILED)
+        {
+            throwSystemError("Cannot remap file");
+        }
+        return static_cast<T*>(address);
+#else
+        T* newArray = map(newCapacity);
+        ::munmap(array, currentCapacity * sizeof(T));
+        return newArray;
+#endif
+    }
+
+    void close()
+    {
+        if (array != nullptr)
+        {
+            ::munmap(array, currentCapacity * sizeof(T));
+            array = nullptr;
+        }
+        if (fd >= 0)
+        {
+            if (mode == MapMode::ReadWrite && count != currentCapacity)
+            {
+                // Nothing useful can be done about a failure while closing.
+                (void) ::ftruncate(fd, static_cast<off_t>(count * sizeof(T)));
+            }
+            ::close(fd);
+            fd = -1;
+        }
+    }
+};
+} // namespace ds
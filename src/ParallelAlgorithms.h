@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "Array.h"
+#include "ThreadPool.h"
+
+namespace ds
+{
+namespace parallel
+{
+
+// Smallest number of elements handed to a single task.
+constexpr size_t DEFAULT_GRAIN_SIZE = 16 * 1024;
+
+namespace detail
+{
+
+inline size_t taskCountFor(size_t n, size_t grainSize)
+{
+    grainSize = grainSize == 0 ? 1 : grainSize;
+    return (n + grainSize - 1) / grainSize;
+}
+
+// Calls fn(first, last) on consecutive slices of [0, n) of at most grainSize elements.
+template <typename Fn>
+void forEachSlice(ThreadPool& pool, size_t n, size_t grainSize, Fn&& fn)
+{
+    size_t tasks = taskCountFor(n, grainSize);
+    size_t sliceSize = tasks == 0 ? 0 : (n + tasks - 1) / tasks;
+    pool.run(tasks, [&](size_t task) {
+        size_t first = task * sliceSize;
+        size_t last = std::min(n, first + sliceSize);
+        fn(first, last);
+    });
+}
+
+// Output iterator that move-constructs every element assigned through it into raw storage.
+template <typename T>
+class ConstructingIterator
+{
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    explicit ConstructingIterator(T* iOut) : out(iOut)
+    {
+    }
+
+    ConstructingIterator& operator*()
+    {
+        return *this;
+    }
+    ConstructingIterator& operator++()
+    {
+        ++out;
+        return *this;
+    }
+    ConstructingIterator operator++(int)
+    {
+        ConstructingIterator tmp(*this);
+        ++out;
+        return tmp;
+    }
+    ConstructingIterator& operator=(T&& value)
+    {
+        new (out) T(std::move(value));
+        return *this;
+    }
+
+  private:
+    T* out;
+};
+
+// Destroys the first count elements of data, which a sort constructed by hand.
+template <typename T>
+struct ConstructedRange
+{
+    ~ConstructedRange()
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            data[i].~T();
+        }
+    }
+
+    T* data;
+    size_t count;
+};
+
+// Merges the sorted runs [lo, mid) and [mid, hi) of source into destination at lo. The first run is
+// cut into pieces and the matching cut points in the second run are found by binary search, so
+// every piece is merged by its own task. All cut points are found before any element is moved.
+// When construct is set, destination is raw storage and the elements are move-constructed into it.
+template <typename T, typename Compare>
+void mergeRuns(ThreadPool& pool, T* source, T* destination, bool construct, size_t lo, size_t mid,
+               size_t hi, size_t grainSize, Compare& compare)
+{
+    size_t pieces = std::max<size_t>(1, detail::taskCountFor(hi - lo, grainSize));
+    pieces = std::min(pieces, std::max<size_t>(1, mid - lo));
+
+    Array<size_t> cutsA;
+    Array<size_t> cutsB;
+    cutsA.resize(pieces + 1);
+    cutsB.resize(pieces + 1);
+    cutsA[0] = lo;
+    cutsB[0] = mid;
+    cutsA[pieces] = mid;
+    cutsB[pieces] = hi;
+    pool.run(pieces - 1, [&](size_t piece) {
+        size_t cut = lo + (piece + 1) * (mid - lo) / pieces;
+        cutsA[piece + 1] = cut;
+        cutsB[piece + 1] =
+            std::lower_bound(source + mid, source + hi, source[cut], compare) - source;
+    });
+
+    pool.run(pieces, [&](size_t piece) {
+        T* out = destination + cutsA[piece] + (cutsB[piece] - mid);
+        auto firstA = std::make_move_iterator(source + cutsA[piece]);
+        auto lastA = std::make_move_iterator(source + cutsA[piece + 1]);
+        auto firstB = std::make_move_iterator(source + cutsB[piece]);
+        auto lastB = std::make_move_iterator(source + cutsB[piece + 1]);
+        if (construct)
+        {
+            std::merge(firstA, lastA, firstB, lastB, ConstructingIterator<T>(out), compare);
+        }
+        else
+        {
+            std::merge(firstA, lastA, firstB, lastB, out, compare);
+        }
+    });
+}
+} // namespace detail
+
+// Calls fn on every element.
+template <typename T, typename Allocator, typename GrowthPolicy, typename Fn>
+void forEach(ThreadPool& pool, Array<T, Allocator, GrowthPolicy>& array, Fn fn,
+             size_t grainSize = DEFAULT_GRAIN_SIZE)
+{
+    T* data = array.data();
+    detail::forEachSlice(pool, array.size(), grainSize, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+        {
+            fn(data[i]);
+        }
+    });
+}
+
+// Replaces the content of destination with fn applied to every element of source.
+template <typename T, typename Allocator, typename GrowthPolicy, typename U,
+          typename DestinationAllocator, typename DestinationGrowthPolicy, typename Fn>
+void transform(ThreadPool& pool, const Array<T, Allocator, GrowthPolicy>& source,
+               Array<U, DestinationAllocator, DestinationGrowthPolicy>& destination, Fn fn,
+               size_t grainSize = DEFAULT_GRAIN_SIZE)
+{
+    destination.resize(source.size());
+    const T* in = source.data();
+    U* out = destination.data();
+    detail::forEachSlice(pool, source.size(), grainSize, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+        {
+            out[i] = fn(in[i]);
+        }
+    });
+}
+
+// op must be associative; slices are reduced independently and then combined in order.
+template <typename T, typename Allocator, typename GrowthPolicy, typename Result, typename Op>
+Result reduce(ThreadPool& pool, const Array<T, Allocator, GrowthPolicy>& array, Result init,
+              Op op, size_t grainSize = DEFAULT_GRAIN_SIZE)
+{
+    size_t tasks = detail::taskCountFor(array.size(), grainSize);
+    if (tasks == 0)
+    {
+        return init;
+    }
+
+    Array<Result> partials;
+    partials.reserve(tasks);
+    for (size_t i = 0; i < tasks; ++i)
+    {
+        partials.pushBack(init);
+    }
+
+    const T* data = array.data();
+    size_t sliceSize = (array.size() + tasks - 1) / tasks;
+    pool.run(tasks, [&](size_t task) {
+        size_t first = task * sliceSize;
+        size_t last = std::min(array.size(), first + sliceSize);
+        if (first >= last)
+        {
+            return;
+        }
+        Result partial = data[first];
+        for (size_t i = first + 1; i < last; ++i)
+        {
+            partial = op(std::move(partial), data[i]);
+        }
+        partials[task] = std::move(partial);
+    });
+
+    Result result = std::move(init);
+    for (size_t task = 0; task < tasks; ++task)
+    {
+        if (task * sliceSize < array.size())
+        {
+            result = op(std::move(result), std::move(partials[task]));
+        }
+    }
+    return result;
+}
+
+// Parallel merge sort: slices are sorted with std::sort, then merged pairwise with every merge
+// split across the pool. Not stable. The merge buffer comes from the array's allocator and its
+// elements are move-constructed by the first merge pass.
+template <typename T, typename Allocator, typename GrowthPolicy, typename Compare = std::less<T>>
+void sort(ThreadPool& pool, Array<T, Allocator, GrowthPolicy>& array, Compare compare = Compare{},
+          size_t grainSize = DEFAULT_GRAIN_SIZE)
+{
+    size_t n = array.size();
+    size_t runs = std::min(detail::taskCountFor(n, grainSize), 4 * pool.size());
+    if (runs <= 1)
+    {
+        std::sort(array.begin(), array.end(), compare);
+        return;
+    }
+
+    Array<size_t> bounds;
+    for (size_t i = 0; i <= runs; ++i)
+    {
+        bounds.pushBack(i * n / runs);
+    }
+
+    T* data = array.data();
+    pool.run(runs, [&](size_t run) {
+        std::sort(data + bounds[run], data + bounds[run + 1], compare);
+    });
+
+    // The buffer only provides storage: its elements are constructed and destroyed here, and
+    // each pass covers all of [0, n), so the first one constructs every element.
+    Array<T, Allocator, GrowthPolicy> buffer(array.getAllocator());
+    buffer.reserve(n);
+    detail::ConstructedRange<T> constructed{buffer.data(), 0};
+    T* source = data;
+    T* destination = buffer.data();
+
+    while (bounds.size() > 2)
+    {
+        bool construct = constructed.count == 0;
+        Array<size_t> merged;
+        size_t i = 0;
+        for (; i + 2 < bounds.size(); i += 2)
+        {
+            detail::mergeRuns(pool, source, destination, construct, bounds[i], bounds[i + 1],
+                              bounds[i + 2], grainSize, compare);
+            merged.pushBack(bounds[i]);
+        }
+        if (i + 1 < bounds.size())
+        {
+            size_t lo = bounds[i];
+            size_t hi = bounds[i + 1];
+            detail::forEachSlice(pool, hi - lo, grainSize, [&](size_t first, size_t last) {
+                auto begin = std::make_move_iterator(source + lo + first);
+                auto end = std::make_move_iterator(source + lo + last);
+                if (construct)
+                {
+                    std::uninitialized_copy(begin, end, destination + lo + first);
+                }
+                else
+                {
+                    std::copy(begin, end, destination + lo + first);
+                }
+            });
+            merged.pushBack(lo);
+        }
+        if (construct)
+        {
+            constructed.count = n;
+        }
+        merged.pushBack(n);
+        bounds = std::move(merged);
+        std::swap(source, destination);
+    }
+
+    if (source != data)
+    {
+        detail::forEachSlice(pool, n, grainSize, [&](size_t first, size_t last) {
+            std::move(source + first, source + last, data + first);
+        });
+    }
+}
+} // namespace parallel
+} // namespace ds
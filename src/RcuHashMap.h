@@ -0,0 +1,309 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "Hash.h"
+#include "HashMap.h"
+
+namespace ds
+{
+
+// Read-mostly HashMap using read-copy-update. Readers see an immutable version of the table and
+// never lock or perform an atomic read-modify-write: each reader thread owns a Reader, which
+// announces the epoch it reads in on its own cache line. Writers are serialized, copy the current
+// table, apply their change, publish the copy and free the old version once every reader that
+// could still see it has left. Writes therefore cost O(size()) and wait for readers, which suits
+// maps read on every request and updated rarely.
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename KeyEqual = EqualTo<Key>>
+class RcuHashMap
+{
+  public:
+    using ValueType = std::pair<const Key, Value>;
+    using Table = HashMap<Key, Value, Hasher, KeyEqual>;
+    class Reader;
+    class Snapshot;
+
+    // At most maxReaders Reader objects may exist at the same time.
+    explicit RcuHashMap(size_t maxReaders = DEFAULT_READERS, const Hasher& iHasher = Hasher(),
+                        const KeyEqual& iKeyEqual = KeyEqual())
+        : slots(new ReaderSlot[maxReaders]), slotCount(maxReaders),
+          current(new Table(iHasher, iKeyEqual))
+    {
+    }
+
+    RcuHashMap(const RcuHashMap<Key, Value, Hasher, KeyEqual>&) = delete;
+    RcuHashMap<Key, Value, Hasher, KeyEqual>&
+    operator=(const RcuHashMap<Key, Value, Hasher, KeyEqual>&) = delete;
+
+    // Every Reader must be destroyed before the map.
+    ~RcuHashMap()
+    {
+        delete current.load(std::memory_order_relaxed);
+    }
+
+    // Claims a reader slot for the calling thread. Throws std::runtime_error if all maxReaders
+    // slots are taken.
+    Reader reader()
+    {
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            bool expected = false;
+            if (!slots[i].claimed.load(std::memory_order_relaxed) &&
+                slots[i].claimed.compare_exchange_strong(expected, true))
+            {
+                return Reader(*this, slots[i]);
+            }
+        }
+        throw std::runtime_error("RcuHashMap has no free reader slot");
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        return current.load(std::memory_order_relaxed)->size();
+    }
+
+    bool isEmpty() const
+    {
+        return size() == 0;
+    }
+
+    // Throws std::runtime_error if the key is already present.
+    void insert(const ValueType& pair)
+    {
+        update([&](Table& table) { table.insert(pair); });
+    }
+
+    // Returns true if the key was inserted, false if an existing value was replaced.
+    bool insertOrAssign(const Key& key, const Value& value)
+    {
+        bool inserted = false;
+        update([&](Table& table) { inserted = table.insertOrAssign(key, value).second; });
+        return inserted;
+    }
+
+    // Returns true if the key was present.
+    bool erase(const Key& key)
+    {
+        bool erased = false;
+        update([&](Table& table) {
+            size_t before = table.size();
+            table.erase(key);
+            erased = table.size() != before;
+        });
+        return erased;
+    }
+
+    void clear()
+    {
+        update([](Table& table) { table.clear(); });
+    }
+
+    // Applies fn to a copy of the current table and publishes the result, so readers see either
+    // none or all of its changes. If fn throws, nothing is published. Returns once no reader can
+    // see the previous version any more; fn must not use this map.
+    template <typename Fn>
+    void update(Fn fn)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::unique_ptr<Table> next(new Table(*current.load(std::memory_order_relaxed)));
+        fn(*next);
+        std::unique_ptr<Table> previous(current.exchange(next.release()));
+        synchronize();
+    }
+
+  private:
+    constexpr static size_t DEFAULT_READERS = 64;
+    constexpr static size_t CACHE_LINE_SIZE = 64;
+    constexpr static uint64_t QUIESCENT = 0;
+
+    struct ReaderSlot
+    {
+        // Epoch the reader entered its snapshot in, or QUIESCENT outside of one.
+        std::atomic<uint64_t> epoch{QUIESCENT};
+        std::atomic<bool> claimed{false};
+        // Keeps the slot of one reader off the cache lines of the others.
+        char padding[CACHE_LINE_SIZE];
+    };
+
+    std::unique_ptr<ReaderSlot[]> slots;
+    size_t slotCount;
+    std::atomic<Table*> current;
+    std::atomic<uint64_t> epoch{1};
+    mutable std::mutex writeMutex;
+
+    // Waits for the grace period of the version just replaced: readers that entered before the
+    // epoch advances may still hold it, those entering after can only load the new one.
+    void synchronize()
+    {
+        uint64_t target = epoch.fetch_add(1) + 1;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            uint64_t seen = slots[i].epoch.load(std::memory_order_acquire);
+            while (seen != QUIESCENT && seen < target)
+            {
+                std::this_thread::yield();
+                seen = slots[i].epoch.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    // Pairs with the fence in synchronize(): either the writer sees the announced epoch and
+    // waits, or this load sees the version the writer published.
+    const Table* enter(ReaderSlot& slot) const
+    {
+        slot.epoch.store(epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return current.load(std::memory_order_acquire);
+    }
+
+    static void leave(ReaderSlot& slot)
+    {
+        slot.epoch.store(QUIESCENT, std::memory_order_release);
+    }
+};
+
+// Handle through which one thread reads the map. Not thread-safe itself: each reading thread
+// needs its own, typically created once and kept for the life of the thread.
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+class RcuHashMap<Key, Value, Hasher, KeyEqual>::Reader
+{
+  public:
+    Reader(Reader&& other) noexcept : map(other.map), slot(other.slot), depth(other.depth)
+    {
+        other.slot = nullptr;
+    }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    Reader& operator=(Reader&&) = delete;
+
+    ~Reader()
+    {
+        if (slot != nullptr)
+        {
+            slot->claimed.store(false, std::memory_order_release);
+        }
+    }
+
+    // Pins the current version until the snapshot is destroyed. Writers wait for it, so keep it
+    // short-lived.
+    Snapshot snapshot()
+    {
+        return Snapshot(*this);
+    }
+
+    // Throws std::out_of_range if the key is absent.
+    Value at(const Key& key)
+    {
+        Snapshot current(*this);
+        return current.at(key);
+    }
+
+    bool contains(const Key& key)
+    {
+        Snapshot current(*this);
+        return current.contains(key);
+    }
+
+  private:
+    Reader(RcuHashMap<Key, Value, Hasher, KeyEqual>& iMap, ReaderSlot& iSlot)
+        : map(&iMap), slot(&iSlot)
+    {
+    }
+
+    RcuHashMap<Key, Value, Hasher, KeyEqual>* map;
+    ReaderSlot* slot;
+    // Snapshots nest: only the outermost one announces and clears the epoch.
+    unsigned depth = 0;
+
+    friend class RcuHashMap;
+};
+
+// One version of the table, kept alive for as long as the snapshot exists.
+template <typename Key, typename Value, typename Hasher, typename KeyEqual>
+class RcuHashMap<Key, Value, Hasher, KeyEqual>::Snapshot
+{
+  public:
+    Snapshot(Snapshot&& other) noexcept : reader(other.reader), table(other.table)
+    {
+        other.reader = nullptr;
+    }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+
+    ~Snapshot()
+    {
+        if (reader != nullptr && --reader->depth == 0)
+        {
+            leave(*reader->slot);
+        }
+    }
+
+    // Other readers share the version, so entries are only handed out as const.
+    size_t size() const
+    {
+        return table->size();
+    }
+
+    bool isEmpty() const
+    {
+        return table->isEmpty();
+    }
+
+    // Throws std::out_of_range if the key is absent.
+    const Value& at(const Key& key) const
+    {
+        return table->at(key);
+    }
+
+    // Returns the entry with the given key, or nullptr if there is none.
+    const ValueType* find(const Key& key) const
+    {
+        return table->find(key);
+    }
+
+    bool contains(const Key& key) const
+    {
+        return table->contains(key);
+    }
+
+    typename Table::ConstIterator begin() const
+    {
+        return table->begin();
+    }
+
+    typename Table::ConstIterator end() const
+    {
+        return table->end();
+    }
+
+  private:
+    explicit Snapshot(Reader& iReader) : reader(&iReader)
+    {
+        if (reader->depth++ == 0)
+        {
+            table = reader->map->enter(*reader->slot);
+        }
+        else
+        {
+            table = reader->map->current.load(std::memory_order_acquire);
+        }
+    }
+
+    Reader* reader;
+    const Table* table;
+
+    friend class RcuHashMap;
+};
+} // namespace ds
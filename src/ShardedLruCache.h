@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "Hash.h"
+#include "LruCache.h"
+
+namespace ds
+{
+
+// Thread-safe LruCache split into independent shards, each an LruCache behind its own mutex. The
+// capacity is divided evenly between the shards and each one evicts on its own, so the cache as a
+// whole only approximates LRU order. Values are returned by copy since a pointer could outlive the
+// lock.
+template <typename Key, typename Value, typename Hasher = Hash<Key>,
+          typename KeyEqual = EqualTo<Key>, typename Cost = UnitCost>
+class ShardedLruCache
+{
+  public:
+    using Shard = LruCache<Key, Value, Hasher, KeyEqual, Cost>;
+
+    // The shard count is rounded up to a power of two; every shard gets at least a capacity of 1.
+    explicit ShardedLruCache(size_t capacity, size_t shardCount = DEFAULT_SHARDS,
+                             const Cost& iCost = Cost(), const Hasher& iHasher = Hasher(),
+                             const KeyEqual& iKeyEqual = KeyEqual())
+        : hasher(iHasher)
+    {
+        while ((size_t{1} << shardBits) < shardCount)
+        {
+            ++shardBits;
+        }
+        size_t count = size_t{1} << shardBits;
+        size_t shardCapacity = capacity / count > 0 ? capacity / count : 1;
+        shards.reset(new Slot[count]);
+        for (size_t i = 0; i < count; ++i)
+        {
+            shards[i].cache.reset(new Shard(shardCapacity, iCost, iHasher, iKeyEqual));
+        }
+    }
+
+    ShardedLruCache(const ShardedLruCache<Key, Value, Hasher, KeyEqual, Cost>&) = delete;
+    ShardedLruCache<Key, Value, Hasher, KeyEqual, Cost>&
+    operator=(const ShardedLruCache<Key, Value, Hasher, KeyEqual, Cost>&) = delete;
+
+    // Not atomic with respect to concurrent writers: shards are counted one after the other.
+    size_t size() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < shardCount(); ++i)
+        {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            total += shards[i].cache->size();
+        }
+        return total;
+    }
+
+    bool isEmpty() const
+    {
+        return size() == 0;
+    }
+
+    size_t shardCount() const
+    {
+        return size_t{1} << shardBits;
+    }
+
+    // Copies the value of key into value and marks it most recently used. Returns false, leaving
+    // value untouched, if the key is not cached.
+    bool get(const Key& key, Value& value)
+    {
+        Slot& slot = slotFor(key);
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        Value* found = slot.cache->get(key);
+        if (found == nullptr)
+        {
+            return false;
+        }
+        value = *found;
+        return true;
+    }
+
+    bool contains(const Key& key) const
+    {
+        Slot& slot = slotFor(key);
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        return slot.cache->contains(key);
+    }
+
+    // See LruCache::put.
+    bool put(const Key& key, Value value)
+    {
+        Slot& slot = slotFor(key);
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        return slot.cache->put(key, std::move(value));
+    }
+
+    // Returns true if the key was cached.
+    bool erase(const Key& key)
+    {
+        Slot& slot = slotFor(key);
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        return slot.cache->erase(key);
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < shardCount(); ++i)
+        {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            shards[i].cache->clear();
+        }
+    }
+
+  private:
+    constexpr static size_t DEFAULT_SHARDS = 16;
+    constexpr static size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot
+    {
+        mutable std::mutex mutex;
+        std::unique_ptr<Shard> cache;
+        // Keeps the lock of one shard off the cache lines of its neighbours.
+        char padding[CACHE_LINE_SIZE];
+    };
+
+    Hasher hasher;
+    std::unique_ptr<Slot[]> shards;
+    unsigned shardBits = 0;
+
+    // Shards are picked with the low bits of mixHash. The FlatHashMap inside each shard indexes
+    // with the top bits of a different product of the hash, so keys of one shard still spread
+    // over its whole table.
+    Slot& slotFor(const Key& key) const
+    {
+        return shards[mixHash(hasher(key)) & (shardCount() - 1)];
+    }
+};
+} // namespace ds
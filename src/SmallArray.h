@@ -0,0 +1,339 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Array.h"
+
+namespace ds
+{
+
+// Array that keeps its first N elements inside the object and only allocates once it overflows.
+template <typename T, size_t N>
+class SmallArray
+{
+  public:
+    using Iterator = typename Array<T>::Iterator;
+    using ConstIterator = typename Array<T>::ConstIterator;
+
+    static_assert(N > 0, "SmallArray needs at least one inline element");
+
+    SmallArray() = default;
+
+    SmallArray(const SmallArray<T, N>& other)
+    {
+        reserve(other.count);
+        try
+        {
+            for (; count < other.count; ++count)
+            {
+                new (array + count) T(other.array[count]);
+            }
+        }
+        catch (...)
+        {
+            clear();
+            releaseHeap();
+            throw;
+        }
+    }
+
+    SmallArray(SmallArray<T, N>&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        takeFrom(other);
+    }
+
+    SmallArray<T, N>& operator=(const SmallArray<T, N>& other)
+    {
+        if (this != &other)
+        {
+            SmallArray<T, N> copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SmallArray<T, N>& operator=(SmallArray<T, N>&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other)
+        {
+            clear();
+            releaseHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallArray()
+    {
+        clear();
+        releaseHeap();
+    }
+
+    void swap(SmallArray<T, N>& other)
+    {
+        if (!isInline() && !other.isInline())
+        {
+            std::swap(array, other.array);
+            std::swap(count, other.count);
+            std::swap(currentCapacity, other.currentCapacity);
+            return;
+        }
+
+        SmallArray<T, N> tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    T& operator[](size_t i) const
+    {
+        return array[i];
+    }
+
+    T& at(size_t i) const
+    {
+        if (i >= count)
+        {
+            throw std::out_of_range("Out of bounds in at() method");
+        }
+        return array[i];
+    }
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    size_t capacity() const
+    {
+        return currentCapacity;
+    }
+
+    bool isInline() const
+    {
+        return array == inlineData();
+    }
+
+    void reserve(size_t newCapacity)
+    {
+        if (newCapacity <= currentCapacity)
+        {
+            return;
+        }
+
+        void* data = std::malloc(newCapacity * sizeof(T));
+        if (data == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        T* newArray = static_cast<T*>(data);
+        relocate(newArray, IsTriviallyRelocatable<T>{});
+        releaseHeap();
+        array = newArray;
+        currentCapacity = newCapacity;
+    }
+
+    void resize(size_t newSize)
+    {
+        if (newSize < count)
+        {
+            destroyRange(newSize, count);
+            count = newSize;
+            return;
+        }
+
+        reserve(newSize);
+        for (; count < newSize; ++count)
+        {
+            new (array + count) T();
+        }
+    }
+
+    void clear()
+    {
+        destroyRange(0, count);
+        count = 0;
+    }
+
+    void pushBack(const T& data)
+    {
+        emplaceBack(data);
+    }
+
+    void pushBack(T&& data)
+    {
+        emplaceBack(std::move(data));
+    }
+
+    template <typename... Args>
+    T& emplaceBack(Args&&... args)
+    {
+        if (count == currentCapacity)
+        {
+            T data(std::forward<Args>(args)...);
+            reserve(currentCapacity * 2);
+            new (array + count) T(std::move(data));
+            return array[count++];
+        }
+        new (array + count) T(std::forward<Args>(args)...);
+        return array[count++];
+    }
+
+    T popBack()
+    {
+        if (count == 0)
+        {
+            throw std::runtime_error("Method popBack() called on an empty array");
+        }
+
+        T data = std::move(array[count - 1]);
+        array[--count].~T();
+        return data;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(array);
+    }
+
+    Iterator end()
+    {
+        return Iterator(array + count);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(array);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(array + count);
+    }
+
+    Iterator rbegin()
+    {
+        return Iterator(array + count - 1);
+    }
+
+    Iterator rend()
+    {
+        return Iterator(array - 1);
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(array);
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(array + count);
+    }
+
+    ConstIterator crbegin() const
+    {
+        return ConstIterator(array + count - 1);
+    }
+
+    ConstIterator crend() const
+    {
+        return ConstIterator(array - 1);
+    }
+
+  private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[N];
+    T* array = inlineData();
+    size_t count = 0;
+    size_t currentCapacity = N;
+
+    T* inlineData() const
+    {
+        return reinterpret_cast<T*>(const_cast<void*>(static_cast<const void*>(storage)));
+    }
+
+    void releaseHeap()
+    {
+        if (!isInline())
+        {
+            std::free(array);
+            array = inlineData();
+            currentCapacity = N;
+        }
+    }
+
+    void destroyRange(size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            array[i].~T();
+        }
+    }
+
+    void relocate(T* newArray, std::true_type)
+    {
+        if (count > 0)
+        {
+            std::memcpy(static_cast<void*>(newArray), static_cast<void*>(array), count * sizeof(T));
+        }
+    }
+
+    void relocate(T* newArray, std::false_type)
+    {
+        size_t i = 0;
+        try
+        {
+            for (; i < count; ++i)
+            {
+                new (newArray + i) T(std::move_if_noexcept(array[i]));
+            }
+        }
+        catch (...)
+        {
+            destroyRangeOf(newArray, i);
+            std::free(newArray);
+            throw;
+        }
+        destroyRange(0, count);
+    }
+
+    static void destroyRangeOf(T* data, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            data[i].~T();
+        }
+    }
+
+    // Expects this to be empty and inline.
+    void takeFrom(SmallArray<T, N>& other)
+    {
+        if (!other.isInline())
+        {
+            array = other.array;
+            count = other.count;
+            currentCapacity = other.currentCapacity;
+            other.array = other.inlineData();
+            other.count = 0;
+            other.currentCapacity = N;
+            return;
+        }
+
+        for (; count < other.count; ++count)
+        {
+            new (array + count) T(std::move(other.array[count]));
+        }
+        other.clear();
+    }
+};
+} // namespace ds
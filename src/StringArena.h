@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "Array.h"
+#include "Hash.h"
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace ds
+{
+
+// Non-owning view of a string, implicitly built from the string types the compact maps accept.
+struct StringRef
+{
+    StringRef(const char* iData, size_t iLength) : data(iData), length(iLength)
+    {
+    }
+
+    StringRef(const char* iData) : data(iData), length(std::strlen(iData))
+    {
+    }
+
+    StringRef(const std::string& string) : data(string.data()), length(string.size())
+    {
+    }
+
+#if __cplusplus >= 201703L
+    StringRef(std::string_view string) : data(string.data()), length(string.size())
+    {
+    }
+#endif
+
+    std::string str() const
+    {
+        return std::string(data, length);
+    }
+
+    bool operator==(const StringRef& other) const
+    {
+        return length == other.length && std::memcmp(data, other.data, length) == 0;
+    }
+
+    const char* data;
+    size_t length;
+};
+
+// Append-only storage for strings. Each string is copied after a variable-length prefix holding
+// its length, one byte below 128, and is identified by the 32-bit offset of that prefix. Offsets
+// stay valid as the arena grows; pointers returned by get() do not. Strings are never freed one
+// by one: owners rebuild the arena to drop those they no longer use.
+class StringArena
+{
+  public:
+    // Copies string into the arena and returns its offset. Throws std::runtime_error if the arena
+    // would outgrow 32-bit offsets.
+    uint32_t append(StringRef string)
+    {
+        unsigned char prefix[PREFIX_MAX_BYTES];
+        size_t prefixLength = 0;
+        size_t length = string.length;
+        do
+        {
+            unsigned char byte = length & 0x7F;
+            length >>= 7;
+            prefix[prefixLength++] = length != 0 ? byte | 0x80 : byte;
+        } while (length != 0);
+
+        size_t offset = bytes.size();
+        if (string.length > MAX_BYTES || offset + prefixLength + string.length > MAX_BYTES)
+        {
+            throw std::runtime_error("StringArena cannot hold more than 4 GiB");
+        }
+        bytes.append(prefix, prefix + prefixLength);
+        bytes.append(string.data, string.data + string.length);
+        return static_cast<uint32_t>(offset);
+    }
+
+    StringRef get(uint32_t offset) const
+    {
+        const unsigned char* position = reinterpret_cast<const unsigned char*>(&bytes[offset]);
+        size_t length = *position & 0x7F;
+        for (unsigned bits = 7; *position++ & 0x80; bits += 7)
+        {
+            length |= static_cast<size_t>(*position & 0x7F) << bits;
+        }
+        return StringRef(reinterpret_cast<const char*>(position), length);
+    }
+
+    // Bytes used by the strings and their prefixes.
+    size_t size() const
+    {
+        return bytes.size();
+    }
+
+    size_t capacity() const
+    {
+        return bytes.capacity();
+    }
+
+    void reserve(size_t byteCount)
+    {
+        bytes.reserve(byteCount);
+    }
+
+    void shrinkToFit()
+    {
+        bytes.shrinkToFit();
+    }
+
+    void clear()
+    {
+        bytes.clear();
+    }
+
+  private:
+    constexpr static size_t MAX_BYTES = UINT32_MAX;
+    constexpr static size_t PREFIX_MAX_BYTES = 10;
+
+    Array<char> bytes;
+};
+
+namespace detail
+{
+
+// Key of the tables indexing an arena: where the string is, and its hash, so that growing the
+// table never reads the arena and most mismatches are rejected without comparing bytes.
+struct ArenaKey
+{
+    uint32_t offset;
+    uint32_t hash;
+};
+
+// A string being looked up, hashed once.
+struct ArenaLookup
+{
+    explicit ArenaLookup(StringRef iString) : string(iString), hash(hashOf(iString))
+    {
+    }
+
+    static uint32_t hashOf(StringRef string)
+    {
+        return static_cast<uint32_t>(hashBytes(string.data, string.length));
+    }
+
+    StringRef string;
+    uint32_t hash;
+};
+
+struct ArenaKeyHash
+{
+    using is_transparent = void;
+
+    size_t operator()(const ArenaKey& key) const
+    {
+        return key.hash;
+    }
+
+    size_t operator()(const ArenaLookup& lookup) const
+    {
+        return lookup.hash;
+    }
+};
+
+// Keys of one table are unique, so two stored keys are equal only if they share an offset.
+struct ArenaKeyEqual
+{
+    using is_transparent = void;
+
+    explicit ArenaKeyEqual(const StringArena* iArena = nullptr) : arena(iArena)
+    {
+    }
+
+    bool operator()(const ArenaKey& lhs, const ArenaKey& rhs) const
+    {
+        return lhs.offset == rhs.offset;
+    }
+
+    bool operator()(const ArenaKey& lhs, const ArenaLookup& rhs) const
+    {
+        return lhs.hash == rhs.hash && arena->get(lhs.offset) == rhs.string;
+    }
+
+    const StringArena* arena;
+};
+} // namespace detail
+} // namespace ds
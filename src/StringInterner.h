@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "FlatHashMap.h"
+#include "StringArena.h"
+
+namespace ds
+{
+
+// Stores every distinct string once in a StringArena and names it by a stable 32-bit id, its
+// offset in the arena. Equal strings intern to the same id, so ids can be compared and hashed
+// instead of the strings, and a string repeated across many records costs its bytes once.
+// Strings are never removed. The table points into the arena, so an interner cannot be copied or
+// moved.
+class StringInterner
+{
+  public:
+    // An enumerator rather than a static member, so that it can be bound to a reference without
+    // needing a definition outside the class.
+    enum : uint32_t
+    {
+        NOT_FOUND = UINT32_MAX
+    };
+
+    StringInterner() : ids(detail::ArenaKeyHash(), detail::ArenaKeyEqual(&arena))
+    {
+    }
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    // Number of distinct strings.
+    size_t size() const
+    {
+        return ids.size();
+    }
+
+    // Returns the id of string, storing it first if it was not interned yet.
+    uint32_t intern(StringRef string)
+    {
+        detail::ArenaLookup lookup(string);
+        std::pair<const detail::ArenaKey, bool>* entry = ids.find(lookup);
+        if (entry != nullptr)
+        {
+            return entry->first.offset;
+        }
+        uint32_t id = arena.append(string);
+        ids[detail::ArenaKey{id, lookup.hash}] = true;
+        return id;
+    }
+
+    // Returns the id of string, or NOT_FOUND if it was never interned.
+    uint32_t find(StringRef string) const
+    {
+        std::pair<const detail::ArenaKey, bool>* entry = ids.find(detail::ArenaLookup(string));
+        return entry == nullptr ? NOT_FOUND : entry->first.offset;
+    }
+
+    // The string with the given id. Valid until the next intern() of a new string.
+    StringRef get(uint32_t id) const
+    {
+        return arena.get(id);
+    }
+
+    // Bytes held by the arena, strings and length prefixes.
+    size_t bytes() const
+    {
+        return arena.size();
+    }
+
+  private:
+    StringArena arena;
+    FlatHashMap<detail::ArenaKey, bool, detail::ArenaKeyHash, detail::ArenaKeyEqual> ids;
+};
+} // namespace ds
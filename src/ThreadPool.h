@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Array.h"
+#include "DoublyLinkedList.h"
+
+namespace ds
+{
+
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(size_t threadCount = defaultThreadCount())
+    {
+        threadCount = threadCount == 0 ? 1 : threadCount;
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            workers.emplaceBack([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    size_t size() const
+    {
+        return workers.size();
+    }
+
+    // Calls fn(i) for every i in [0, taskCount) and returns once all calls are done. The calling
+    // thread takes tasks too, so run() may be nested inside a task without deadlocking. The first
+    // exception thrown by a task is rethrown here.
+    template <typename Fn>
+    void run(size_t taskCount, Fn&& fn)
+    {
+        if (taskCount == 0)
+        {
+            return;
+        }
+
+        auto job = std::make_shared<Job>(taskCount, std::function<void(size_t)>(fn));
+        size_t helpers = std::min(taskCount - 1, workers.size());
+        if (helpers > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t i = 0; i < helpers; ++i)
+                {
+                    queue.pushBack(job);
+                }
+            }
+            if (helpers == 1)
+            {
+                wakeUp.notify_one();
+            }
+            else
+            {
+                wakeUp.notify_all();
+            }
+        }
+
+        job->process();
+        job->wait();
+        if (job->error)
+        {
+            std::rethrow_exception(job->error);
+        }
+    }
+
+    static size_t defaultThreadCount()
+    {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+  private:
+    class Job
+    {
+      public:
+        Job(size_t iTaskCount, std::function<void(size_t)> iFn)
+            : taskCount(iTaskCount), fn(std::move(iFn))
+        {
+        }
+
+        void process()
+        {
+            for (size_t i = next.fetch_add(1); i < taskCount; i = next.fetch_add(1))
+            {
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+
+                if (done.fetch_add(1) + 1 == taskCount)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished.notify_all();
+                }
+            }
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [this] { return done.load() == taskCount; });
+        }
+
+        std::exception_ptr error;
+
+      private:
+        const size_t taskCount;
+        std::function<void(size_t)> fn;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    Array<std::thread> workers;
+    DoublyLinkedList<std::shared_ptr<Job>> queue;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+
+    void work()
+    {
+        while (true)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [this] { return stopping || !queue.isEmpty(); });
+                if (queue.isEmpty())
+                {
+                    return;
+                }
+                job = queue.popFront();
+            }
+            job->process();
+        }
+    }
+};
+} // namespace ds
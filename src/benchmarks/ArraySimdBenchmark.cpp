@@ -0,0 +1,112 @@
+#include <cstdint>
+
+#include "ArraySimd.h"
+#include "Benchmark.h"
+
+using ds::Array;
+
+namespace
+{
+constexpr size_t SIZE = 16 * 1024 * 1024;
+
+template <typename T>
+Array<T> makeArray()
+{
+    Array<T> array;
+    array.reserve(SIZE);
+    for (size_t i = 0; i < SIZE; i++)
+    {
+        array.pushBack(static_cast<T>((i * 2654435761u) % 1000));
+    }
+    return array;
+}
+
+template <typename T>
+void run(const char* typeName)
+{
+    Array<T> array = makeArray<T>();
+    Array<T> filtered;
+    filtered.reserve(SIZE);
+    const T missing = static_cast<T>(5000);
+    const T threshold = static_cast<T>(900);
+
+    bench::header(typeName);
+
+    bench::report(
+        "find (miss)",
+        bench::measure([&] {
+            size_t index = 0;
+            for (auto it = array.begin(); it != array.end() && *it != missing; ++it)
+            {
+                index++;
+            }
+            bench::doNotOptimize(index);
+        }),
+        bench::measure([&] { bench::doNotOptimize(ds::find(array, missing)); }));
+
+    bench::report(
+        "count",
+        bench::measure([&] {
+            size_t result = 0;
+            for (auto it = array.begin(); it != array.end(); ++it)
+            {
+                result += *it == threshold;
+            }
+            bench::doNotOptimize(result);
+        }),
+        bench::measure([&] { bench::doNotOptimize(ds::count(array, threshold)); }));
+
+    bench::report(
+        "sum",
+        bench::measure([&] {
+            ds::SumType<T> result = 0;
+            for (auto it = array.begin(); it != array.end(); ++it)
+            {
+                result += *it;
+            }
+            bench::doNotOptimize(result);
+        }),
+        bench::measure([&] { bench::doNotOptimize(ds::sum(array)); }));
+
+    bench::report(
+        "minMax",
+        bench::measure([&] {
+            T min = array[0];
+            T max = array[0];
+            for (auto it = array.begin(); it != array.end(); ++it)
+            {
+                min = *it < min ? *it : min;
+                max = *it > max ? *it : max;
+            }
+            bench::doNotOptimize(min);
+            bench::doNotOptimize(max);
+        }),
+        bench::measure([&] { bench::doNotOptimize(ds::minMax(array)); }));
+
+    bench::report(
+        "filterInto",
+        bench::measure([&] {
+            filtered.clear();
+            for (auto it = array.begin(); it != array.end(); ++it)
+            {
+                if (*it > threshold)
+                {
+                    filtered.pushBack(*it);
+                }
+            }
+            bench::doNotOptimize(filtered.size());
+        }),
+        bench::measure([&] {
+            filtered.clear();
+            bench::doNotOptimize(ds::filterInto(array, threshold, filtered));
+        }));
+}
+} // namespace
+
+int main()
+{
+    run<int32_t>("Array<int32_t>, 16M elements");
+    run<float>("Array<float>, 16M elements");
+    run<double>("Array<double>, 16M elements");
+    return 0;
+}
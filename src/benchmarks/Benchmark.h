@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench
+{
+
+// Runs fn repeatedly and returns the best wall time of one run, in milliseconds.
+template <typename Fn>
+double measure(Fn&& fn, int runs = 5)
+{
+    double best = 0;
+    for (int i = 0; i < runs; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::milli>(stop - start).count();
+        best = i == 0 || elapsed < best ? elapsed : best;
+    }
+    return best;
+}
+
+inline void report(const char* name, double baseline, double optimized)
+{
+    std::printf("%-32s %10.3f ms %10.3f ms %8.2fx\n", name, baseline, optimized,
+                baseline / optimized);
+}
+
+inline void header(const char* title)
+{
+    std::printf("\n%s\n%-32s %13s %13s %9s\n", title, "benchmark", "baseline", "optimized",
+                "speedup");
+}
+
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+} // namespace bench
@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ConcurrentHashMap.h"
+#include "HashMap.h"
+#include "RcuHashMap.h"
+
+using ds::Array;
+
+namespace
+{
+constexpr size_t SIZE = 1 << 20;
+constexpr size_t LOOKUPS_PER_THREAD = 1 << 20;
+
+Array<uint64_t> makeKeys()
+{
+    Array<uint64_t> keys;
+    keys.reserve(SIZE);
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < SIZE; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys.pushBack(state);
+    }
+    return keys;
+}
+
+// Every thread looks up LOOKUPS_PER_THREAD keys, starting at a different offset. makeLookup is
+// called once in each thread and returns the function that thread looks keys up with.
+template <typename MakeLookup>
+void readConcurrently(size_t threadCount, const Array<uint64_t>& keys, MakeLookup makeLookup)
+{
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t] {
+            auto lookup = makeLookup();
+            uint64_t total = 0;
+            size_t offset = t * 7919;
+            for (size_t i = 0; i < LOOKUPS_PER_THREAD; i++)
+            {
+                total += lookup(keys[(offset + i) & (SIZE - 1)]);
+            }
+            bench::doNotOptimize(total);
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+} // namespace
+
+int main()
+{
+    const Array<uint64_t> keys = makeKeys();
+
+    ds::HashMap<uint64_t, uint64_t> locked;
+    std::mutex mutex;
+    ds::ConcurrentHashMap<uint64_t, uint64_t> concurrent;
+    for (size_t i = 0; i < SIZE; i++)
+    {
+        locked.insert(std::pair<const uint64_t, uint64_t>(keys[i], i));
+        concurrent.insertOrAssign(keys[i], i);
+    }
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    bench::header("1M lookups per thread, HashMap + global mutex vs ConcurrentHashMap");
+    for (size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%zu threads", threads);
+        bench::report(name,
+                      bench::measure(
+                          [&] {
+                              readConcurrently(threads, keys, [&] {
+                                  return [&](uint64_t key) {
+                                      std::lock_guard<std::mutex> lock(mutex);
+                                      return locked.at(key);
+                                  };
+                              });
+                          },
+                          3),
+                      bench::measure(
+                          [&] {
+                              readConcurrently(threads, keys, [&] {
+                                  return [&](uint64_t key) { return concurrent.at(key); };
+                              });
+                          },
+                          3));
+    }
+
+    ds::RcuHashMap<uint64_t, uint64_t> rcu;
+    rcu.update([&](ds::RcuHashMap<uint64_t, uint64_t>::Table& table) {
+        for (size_t i = 0; i < SIZE; i++)
+        {
+            table.insertOrAssign(keys[i], i);
+        }
+    });
+
+    bench::header("1M lookups per thread, ConcurrentHashMap vs RcuHashMap");
+    for (size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%zu threads", threads);
+        bench::report(name,
+                      bench::measure(
+                          [&] {
+                              readConcurrently(threads, keys, [&] {
+                                  return [&](uint64_t key) { return concurrent.at(key); };
+                              });
+                          },
+                          3),
+                      bench::measure(
+                          [&] {
+                              readConcurrently(threads, keys, [&] {
+                                  return [reader = rcu.reader()](uint64_t key) mutable {
+                                      return reader.at(key);
+                                  };
+                              });
+                          },
+                          3));
+    }
+    return 0;
+}
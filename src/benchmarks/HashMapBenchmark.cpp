@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "Benchmark.h"
+#include "CompactStringMap.h"
+#include "FlatHashMap.h"
+#include "FrozenHashMap.h"
+#include "HashMap.h"
+
+using ds::Array;
+
+namespace
+{
+Array<uint64_t> makeKeys(size_t n, uint64_t seed)
+{
+    Array<uint64_t> keys;
+    keys.reserve(n);
+    uint64_t state = seed;
+    for (size_t i = 0; i < n; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys.pushBack(state);
+    }
+    return keys;
+}
+
+template <typename Map>
+void fill(Map& map, const Array<uint64_t>& keys)
+{
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        map.insert(std::pair<const uint64_t, uint64_t>(keys[i], i));
+    }
+}
+
+template <typename Map>
+uint64_t lookUpAll(const Map& map, const Array<uint64_t>& keys)
+{
+    uint64_t total = 0;
+    for (uint64_t key : keys)
+    {
+        total += map.at(key);
+    }
+    return total;
+}
+
+template <typename Key, typename Value>
+uint64_t lookUpAll(const ds::FrozenHashMap<Key, Value>& map, const Array<uint64_t>& keys)
+{
+    uint64_t total = 0;
+    for (uint64_t key : keys)
+    {
+        total += map.find(key)->second;
+    }
+    return total;
+}
+
+// Each key depends on the previous result, so lookups cannot overlap and the time is the latency.
+template <typename Map>
+uint64_t chaseAll(const Map& map, const Array<uint64_t>& keys)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        value = map.at(keys[(i + value) % keys.size()]);
+    }
+    return value;
+}
+
+// Request-sized batches of keys, resolved one at() at a time or with findMany().
+template <typename Key>
+uint64_t lookUpBatches(const ds::HashMap<Key, uint64_t>& map, const Array<Key>& keys,
+                       size_t batchSize, bool batched)
+{
+    Array<typename ds::HashMap<Key, uint64_t>::ValueType*> results;
+    results.resize(batchSize);
+    uint64_t total = 0;
+    for (size_t start = 0; start + batchSize <= keys.size(); start += batchSize)
+    {
+        if (batched)
+        {
+            map.findMany(&keys[start], batchSize, &results[0]);
+            for (size_t i = 0; i < batchSize; i++)
+            {
+                total += results[i]->second;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < batchSize; i++)
+            {
+                total += map.at(keys[start + i]);
+            }
+        }
+    }
+    return total;
+}
+
+// Fills a map with keys and reports 1M shuffled lookups of them in batches of 64 and 512.
+template <typename Key>
+void runBatches(const char* title, const Array<Key>& keys)
+{
+    ds::HashMap<Key, uint64_t> map;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        map.tryEmplace(keys[i], i);
+    }
+    Array<Key> lookups = keys;
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(42));
+    lookups.resize(1024 * 1024);
+
+    bench::header(title);
+    for (size_t batchSize : {64, 512})
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "batch of %zu", batchSize);
+        bench::report(name,
+                      bench::measure([&] {
+                          bench::doNotOptimize(lookUpBatches(map, lookups, batchSize, false));
+                      }),
+                      bench::measure([&] {
+                          bench::doNotOptimize(lookUpBatches(map, lookups, batchSize, true));
+                      }));
+    }
+}
+
+// Looks up keys that are all absent, counting the misses the way callers had to before find().
+uint64_t missAllThrowing(const ds::HashMap<uint64_t, uint64_t>& map, const Array<uint64_t>& keys)
+{
+    uint64_t misses = 0;
+    for (uint64_t key : keys)
+    {
+        try
+        {
+            bench::doNotOptimize(map.at(key));
+        }
+        catch (const std::out_of_range&)
+        {
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+uint64_t missAllFind(const ds::HashMap<uint64_t, uint64_t>& map, const Array<uint64_t>& keys)
+{
+    uint64_t misses = 0;
+    for (uint64_t key : keys)
+    {
+        misses += map.find(key) == nullptr;
+    }
+    return misses;
+}
+
+template <typename Key, typename Value>
+uint64_t chaseAll(const ds::FrozenHashMap<Key, Value>& map, const Array<uint64_t>& keys)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        value = map.find(keys[(i + value) % keys.size()])->second;
+    }
+    return value;
+}
+
+void runFrozen(const char* title, size_t n)
+{
+    const Array<uint64_t> keys = makeKeys(n, 88172645463325252ull);
+    ds::FlatHashMap<uint64_t, uint64_t> flat;
+    ds::HashMap<uint64_t, uint64_t> chained;
+    fill(flat, keys);
+    fill(chained, keys);
+    const ds::FrozenHashMap<uint64_t, uint64_t> frozen = ds::freeze(chained);
+
+    Array<uint64_t> shuffled = keys;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(42));
+
+    bench::header(title);
+    bench::report("lookup hit",
+                  bench::measure([&] { bench::doNotOptimize(lookUpAll(flat, shuffled)); }),
+                  bench::measure([&] { bench::doNotOptimize(lookUpAll(frozen, shuffled)); }));
+    bench::report("lookup latency",
+                  bench::measure([&] { bench::doNotOptimize(chaseAll(flat, shuffled)); }),
+                  bench::measure([&] { bench::doNotOptimize(chaseAll(frozen, shuffled)); }));
+}
+
+// Slowest single insertion while filling the map, in milliseconds.
+double worstInsert(const Array<uint64_t>& keys, bool incremental)
+{
+    ds::HashMap<uint64_t, uint64_t> map;
+    map.setIncrementalRehash(incremental);
+    double worst = 0;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        map.insert(std::pair<const uint64_t, uint64_t>(keys[i], i));
+        auto stop = std::chrono::steady_clock::now();
+        worst = std::max(worst, std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+    return worst;
+}
+
+void run(const char* title, size_t n)
+{
+    const Array<uint64_t> keys = makeKeys(n, 88172645463325252ull);
+
+    ds::HashMap<uint64_t, uint64_t> chained;
+    ds::FlatHashMap<uint64_t, uint64_t> flat;
+    fill(chained, keys);
+    fill(flat, keys);
+
+    // Looking keys up in insertion order would walk the chained nodes in allocation order.
+    Array<uint64_t> shuffled = keys;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(42));
+
+    bench::header(title);
+
+    bench::report(
+        "insert",
+        bench::measure([&] {
+            ds::HashMap<uint64_t, uint64_t> map;
+            fill(map, keys);
+            bench::doNotOptimize(map.size());
+        }),
+        bench::measure([&] {
+            ds::FlatHashMap<uint64_t, uint64_t> map;
+            fill(map, keys);
+            bench::doNotOptimize(map.size());
+        }));
+
+    bench::report("lookup hit",
+                  bench::measure([&] { bench::doNotOptimize(lookUpAll(chained, shuffled)); }),
+                  bench::measure([&] { bench::doNotOptimize(lookUpAll(flat, shuffled)); }));
+
+    bench::report("lookup latency",
+                  bench::measure([&] { bench::doNotOptimize(chaseAll(chained, shuffled)); }),
+                  bench::measure([&] { bench::doNotOptimize(chaseAll(flat, shuffled)); }));
+}
+// The same lookups in a map without statistics and in one counting them.
+void runStats(const char* title, size_t n)
+{
+    const Array<uint64_t> keys = makeKeys(n, 88172645463325252ull);
+    Array<uint64_t> shuffled = keys;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(42));
+    ds::HashMap<uint64_t, uint64_t> plain;
+    ds::HashMap<uint64_t, uint64_t, ds::Hash<uint64_t>, ds::EqualTo<uint64_t>, ds::CountingStats>
+        counted;
+    fill(plain, keys);
+    fill(counted, keys);
+
+    bench::header(title);
+    bench::report("lookup hit",
+                  bench::measure([&] { bench::doNotOptimize(lookUpAll(plain, shuffled)); }),
+                  bench::measure([&] { bench::doNotOptimize(lookUpAll(counted, shuffled)); }));
+}
+// Single-threaded inserts, with and without reserve(), against buildFrom() on all hardware threads.
+void runBuild(const char* title, const Array<uint64_t>& keys)
+{
+    Array<std::pair<uint64_t, uint64_t>> pairs;
+    pairs.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        pairs.pushBack(std::pair<uint64_t, uint64_t>(keys[i], i));
+    }
+    ds::ThreadPool pool;
+    double built = bench::measure(
+        [&] {
+            auto map = ds::HashMap<uint64_t, uint64_t>::buildFrom(pool, pairs);
+            bench::doNotOptimize(map.size());
+        },
+        3);
+
+    bench::header(title);
+    bench::report("insert",
+                  bench::measure(
+                      [&] {
+                          ds::HashMap<uint64_t, uint64_t> map;
+                          fill(map, keys);
+                          bench::doNotOptimize(map.size());
+                      },
+                      3),
+                  built);
+    bench::report("reserve + insert",
+                  bench::measure(
+                      [&] {
+                          ds::HashMap<uint64_t, uint64_t> map;
+                          map.reserve(keys.size());
+                          fill(map, keys);
+                          bench::doNotOptimize(map.size());
+                      },
+                      3),
+                  built);
+}
+// Bytes held by a HashMap of strings, including the heap buffers of keys past the small-string
+// limit, which statistics() leaves out.
+size_t memoryOf(const ds::HashMap<std::string, uint64_t>& map)
+{
+    size_t bytes = map.statistics().memoryBytes;
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+    {
+        if (it->first.capacity() > std::string().capacity())
+        {
+            bytes += it->first.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+template <typename Map>
+uint64_t sumValues(const Map& map)
+{
+    uint64_t total = 0;
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+    {
+        total += (*it).second;
+    }
+    return total;
+}
+
+void runCompact(const char* title, const Array<std::string>& keys)
+{
+    ds::HashMap<std::string, uint64_t> strings;
+    ds::CompactStringMap<uint64_t> compact;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        strings[keys[i]] = i;
+        compact[keys[i]] = i;
+    }
+    Array<std::string> shuffled = keys;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(42));
+
+    bench::header(title);
+    std::printf("%-32s %10.1f MB %10.1f MB %8.2fx\n", "memory", memoryOf(strings) / 1e6,
+                compact.statistics().memoryBytes / 1e6,
+                static_cast<double>(memoryOf(strings)) / compact.statistics().memoryBytes);
+    bench::report("lookup hit", bench::measure([&] {
+                      uint64_t total = 0;
+                      for (const std::string& key : shuffled)
+                      {
+                          total += strings.at(key);
+                      }
+                      bench::doNotOptimize(total);
+                  }),
+                  bench::measure([&] {
+                      uint64_t total = 0;
+                      for (const std::string& key : shuffled)
+                      {
+                          total += compact.at(key);
+                      }
+                      bench::doNotOptimize(total);
+                  }));
+    bench::report("scan",
+                  bench::measure([&] { bench::doNotOptimize(sumValues(strings)); }),
+                  bench::measure([&] { bench::doNotOptimize(sumValues(compact)); }));
+}
+} // namespace
+
+int main()
+{
+    run("16K uint64_t keys, HashMap vs FlatHashMap", 16 * 1024);
+    run("1M uint64_t keys, HashMap vs FlatHashMap", 1024 * 1024);
+    runFrozen("16K uint64_t keys, FlatHashMap vs FrozenHashMap", 16 * 1024);
+    runFrozen("1M uint64_t keys, FlatHashMap vs FrozenHashMap", 1024 * 1024);
+    runStats("16K uint64_t keys, HashMap NoStats vs CountingStats", 16 * 1024);
+    runStats("1M uint64_t keys, HashMap NoStats vs CountingStats", 1024 * 1024);
+
+    const Array<uint64_t> keys = makeKeys(4 * 1024 * 1024, 88172645463325252ull);
+    bench::header("4M uint64_t keys, HashMap resize vs incremental rehash");
+    bench::report("worst insert", worstInsert(keys, false), worstInsert(keys, true));
+    bench::header("4M uint64_t keys, HashMap bulk load: default growth vs reserve()");
+    bench::report(
+        "bulk load",
+        bench::measure(
+            [&] {
+                ds::HashMap<uint64_t, uint64_t> map;
+                fill(map, keys);
+                bench::doNotOptimize(map.size());
+            },
+            3),
+        bench::measure(
+            [&] {
+                ds::HashMap<uint64_t, uint64_t> map;
+                map.reserve(keys.size());
+                fill(map, keys);
+                bench::doNotOptimize(map.size());
+            },
+            3));
+
+    runBuild("4M uint64_t pairs, HashMap inserts vs buildFrom()", keys);
+
+    ds::HashMap<uint64_t, uint64_t> map;
+    fill(map, makeKeys(16 * 1024, 88172645463325252ull));
+    const Array<uint64_t> absent = makeKeys(16 * 1024, 2463534242ull);
+    bench::header("16K misses in a 16K-key HashMap, at() + catch vs find()");
+    bench::report("lookup miss",
+                  bench::measure([&] { bench::doNotOptimize(missAllThrowing(map, absent)); }),
+                  bench::measure([&] { bench::doNotOptimize(missAllFind(map, absent)); }));
+
+    runBatches("1M lookups in an 8M-key HashMap, at() vs findMany()",
+               makeKeys(8 * 1024 * 1024, 88172645463325252ull));
+
+    const Array<uint64_t> ids = makeKeys(4 * 1024 * 1024, 88172645463325252ull);
+    Array<std::string> names;
+    names.reserve(ids.size());
+    for (uint64_t id : ids)
+    {
+        names.pushBack("user:" + std::to_string(id));
+    }
+    runBatches("1M lookups in a 4M-key HashMap<std::string>, at() vs findMany()", names);
+
+    Array<std::string> shortNames;
+    Array<std::string> longNames;
+    for (size_t i = 0; i < 1024 * 1024; i++)
+    {
+        shortNames.pushBack("u" + std::to_string(ids[i] % 1000000000));
+        longNames.pushBack(names[i]);
+    }
+    runCompact("1M keys of up to 10 bytes, HashMap<std::string> vs CompactStringMap", shortNames);
+    runCompact("1M \"user:<id>\" keys, HashMap<std::string> vs CompactStringMap", longNames);
+    return 0;
+}
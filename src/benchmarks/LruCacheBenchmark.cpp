@@ -0,0 +1,175 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "DoublyLinkedList.h"
+#include "HashMap.h"
+#include "LruCache.h"
+#include "ShardedLruCache.h"
+
+using ds::Array;
+
+namespace
+{
+constexpr size_t OPERATIONS = 10 * 1000 * 1000;
+
+// The cache built by hand before LruCache: a HashMap from each key to its node in a recency list.
+class ListLruCache
+{
+  public:
+    explicit ListLruCache(size_t iCapacity) : capacity(iCapacity)
+    {
+    }
+
+    uint64_t* get(uint64_t key)
+    {
+        ds::HashMap<uint64_t, Position>::ValueType* found = index.find(key);
+        if (found == nullptr)
+        {
+            return nullptr;
+        }
+        order.splice(order.begin(), order, found->second);
+        return &found->second->second;
+    }
+
+    void put(uint64_t key, uint64_t value)
+    {
+        if (size == capacity)
+        {
+            index.erase(order.getBack().first);
+            order.popBack();
+            --size;
+        }
+        order.emplaceFront(key, value);
+        index.insertOrAssign(key, order.begin());
+        ++size;
+    }
+
+  private:
+    using Position = ds::DoublyLinkedList<std::pair<uint64_t, uint64_t>>::Iterator;
+
+    ds::DoublyLinkedList<std::pair<uint64_t, uint64_t>> order;
+    ds::HashMap<uint64_t, Position> index;
+    size_t capacity;
+    size_t size = 0;
+};
+
+// Keys drawn with a skew towards small ids, so that most requests hit like in a real cache.
+Array<uint64_t> makeRequests(size_t n, size_t keySpace, unsigned seed)
+{
+    std::mt19937_64 random(seed);
+    std::exponential_distribution<double> skew(32.0 / keySpace);
+    Array<uint64_t> requests;
+    requests.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        requests.pushBack(static_cast<uint64_t>(skew(random)) % keySpace);
+    }
+    return requests;
+}
+
+// Read-through use: every miss is followed by a put of the key.
+template <typename Cache>
+uint64_t serve(Cache& cache, const Array<uint64_t>& requests)
+{
+    uint64_t hits = 0;
+    for (uint64_t key : requests)
+    {
+        uint64_t* value = cache.get(key);
+        if (value != nullptr)
+        {
+            hits += *value == key;
+        }
+        else
+        {
+            cache.put(key, key);
+        }
+    }
+    return hits;
+}
+
+void run(const char* title, size_t capacity, size_t keySpace)
+{
+    const Array<uint64_t> requests = makeRequests(OPERATIONS, keySpace, 42);
+    bench::header(title);
+    bench::report("get + put on miss",
+                  bench::measure(
+                      [&] {
+                          ListLruCache cache(capacity);
+                          bench::doNotOptimize(serve(cache, requests));
+                      },
+                      3),
+                  bench::measure(
+                      [&] {
+                          ds::LruCache<uint64_t, uint64_t> cache(capacity);
+                          bench::doNotOptimize(serve(cache, requests));
+                      },
+                      3));
+}
+
+// Every thread serves OPERATIONS / threadCount requests through the shared cache.
+void serveConcurrently(ds::ShardedLruCache<uint64_t, uint64_t>& cache,
+                       const Array<uint64_t>& requests, size_t threadCount)
+{
+    std::vector<std::thread> threads;
+    size_t share = requests.size() / threadCount;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t] {
+            uint64_t hits = 0;
+            for (size_t i = t * share; i < (t + 1) * share; i++)
+            {
+                uint64_t value = 0;
+                if (cache.get(requests[i], value))
+                {
+                    hits += value == requests[i];
+                }
+                else
+                {
+                    cache.put(requests[i], requests[i]);
+                }
+            }
+            bench::doNotOptimize(hits);
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+} // namespace
+
+int main()
+{
+    run("10M requests, 64K-entry cache over 1M keys, HashMap + list vs LruCache", 64 * 1024,
+        1024 * 1024);
+    run("10M requests, 1M-entry cache over 16M keys, HashMap + list vs LruCache", 1024 * 1024,
+        16 * 1024 * 1024);
+
+    const Array<uint64_t> requests = makeRequests(OPERATIONS, 1024 * 1024, 42);
+    std::printf("\nhardware threads: %u\n", std::thread::hardware_concurrency());
+    bench::header("10M requests, 64K entries, 1 shard vs 16 shards");
+    for (size_t threads = 1; threads <= 8; threads *= 2)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%zu threads", threads);
+        bench::report(name,
+                      bench::measure(
+                          [&] {
+                              ds::ShardedLruCache<uint64_t, uint64_t> cache(64 * 1024, 1);
+                              serveConcurrently(cache, requests, threads);
+                          },
+                          3),
+                      bench::measure(
+                          [&] {
+                              ds::ShardedLruCache<uint64_t, uint64_t> cache(64 * 1024, 16);
+                              serveConcurrently(cache, requests, threads);
+                          },
+                          3));
+    }
+    return 0;
+}
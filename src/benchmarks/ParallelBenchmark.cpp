@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+#include "Benchmark.h"
+#include "ParallelAlgorithms.h"
+
+using ds::Array;
+
+namespace
+{
+constexpr size_t SIZE = 16 * 1024 * 1024;
+
+Array<uint64_t> makeArray()
+{
+    Array<uint64_t> array;
+    array.reserve(SIZE);
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < SIZE; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        array.pushBack(state);
+    }
+    return array;
+}
+} // namespace
+
+int main()
+{
+    ds::ThreadPool pool;
+    const Array<uint64_t> input = makeArray();
+    Array<uint64_t> work;
+    Array<double> output;
+
+    std::printf("threads: %zu\n", pool.size());
+    bench::header("16M uint64_t, std:: algorithm vs ds::parallel");
+
+    bench::report(
+        "sort",
+        bench::measure([&] {
+            work = input;
+            std::sort(work.begin(), work.end());
+        }),
+        bench::measure([&] {
+            work = input;
+            ds::parallel::sort(pool, work);
+        }));
+
+    bench::report(
+        "transform",
+        bench::measure([&] {
+            output.resize(input.size());
+            std::transform(input.cbegin(), input.cend(), output.begin(),
+                           [](uint64_t x) { return static_cast<double>(x) * 0.5; });
+        }),
+        bench::measure([&] {
+            ds::parallel::transform(pool, input, output,
+                                    [](uint64_t x) { return static_cast<double>(x) * 0.5; });
+        }));
+
+    bench::report(
+        "reduce",
+        bench::measure([&] {
+            uint64_t total = 0;
+            for (uint64_t value : input)
+            {
+                total += value % 1000;
+            }
+            bench::doNotOptimize(total);
+        }),
+        bench::measure([&] {
+            bench::doNotOptimize(ds::parallel::reduce(
+                pool, input, uint64_t{0}, [](uint64_t a, uint64_t b) { return a + b % 1000; }));
+        }));
+
+    work = input;
+    bench::report(
+        "forEach",
+        bench::measure([&] {
+            for (uint64_t& value : work)
+            {
+                value = value * 2654435761u + 1;
+            }
+        }),
+        bench::measure([&] {
+            ds::parallel::forEach(pool, work,
+                                  [](uint64_t& value) { value = value * 2654435761u + 1; });
+        }));
+    return 0;
+}
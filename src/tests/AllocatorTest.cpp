@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include "Allocator.h"
+#include "Array.h"
+
+using ds::Arena;
+using ds::ArenaAllocator;
+using ds::Array;
+using ds::HugePageAllocator;
+
+class ArenaTest : public ::testing::Test
+{
+  protected:
+    Arena arena{1024};
+};
+
+// --- Arena ---
+TEST_F(ArenaTest, allocate_WhenCalled_ShouldReturnAlignedMemory)
+{
+    arena.allocate(1, 1);
+    void* data = arena.allocate(sizeof(double), alignof(double));
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % alignof(double), 0u);
+}
+TEST_F(ArenaTest, allocate_WhenCalledTwice_ShouldReturnDistinctRegions)
+{
+    char* first = static_cast<char*>(arena.allocate(16, 1));
+    char* second = static_cast<char*>(arena.allocate(16, 1));
+
+    EXPECT_GE(second, first + 16);
+}
+TEST_F(ArenaTest, allocate_WhenLargerThanBlock_ShouldSucceed)
+{
+    arena.allocate(8);
+    char* data = static_cast<char*>(arena.allocate(4096));
+    data[4095] = 'x';
+
+    EXPECT_EQ(arena.bytesUsed(), 4104u);
+}
+TEST_F(ArenaTest, release_WhenCalled_ShouldResetUsage)
+{
+    arena.allocate(100);
+
+    arena.release();
+
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+}
+TEST_F(ArenaTest, reset_WhenCalled_ShouldReuseCurrentBlock)
+{
+    void* first = arena.allocate(16);
+
+    arena.reset();
+
+    EXPECT_EQ(arena.allocate(16), first);
+}
+
+// --- Array with allocators ---
+TEST_F(ArenaTest, pushBack_WhenUsingArenaAllocator_ShouldStoreElementsInArena)
+{
+    Array<int, ArenaAllocator<int>> values{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 100; i++)
+    {
+        values.pushBack(i);
+    }
+
+    EXPECT_EQ(values[99], 99);
+    EXPECT_GT(arena.bytesUsed(), 100 * sizeof(int));
+}
+TEST_F(ArenaTest, copyConstructor_WhenUsingArenaAllocator_ShouldShareArena)
+{
+    Array<std::string, ArenaAllocator<std::string>> values{ArenaAllocator<std::string>(arena)};
+    values.pushBack("value");
+
+    Array<std::string, ArenaAllocator<std::string>> copy(values);
+
+    EXPECT_EQ(copy[0], "value");
+    EXPECT_TRUE(copy.getAllocator() == values.getAllocator());
+}
+TEST(ArenaAllocatorTest, copyAssignment_WhenSourceUsesOtherArena_ShouldKeepItsOwnArena)
+{
+    Arena first;
+    Arena second;
+    Array<int, ArenaAllocator<int>> destination{ArenaAllocator<int>(first)};
+    Array<int, ArenaAllocator<int>> source{ArenaAllocator<int>(second)};
+    for (int i = 0; i < 100; i++)
+    {
+        source.pushBack(i);
+    }
+    size_t usedBefore = first.bytesUsed();
+
+    destination = source;
+    second.release();
+
+    EXPECT_TRUE(destination.getAllocator() == ArenaAllocator<int>(first));
+    EXPECT_GT(first.bytesUsed(), usedBefore);
+    EXPECT_EQ(destination.size(), 100u);
+    EXPECT_EQ(destination[99], 99);
+}
+TEST(ArenaAllocatorTest, moveAssignment_WhenSourceUsesOtherArena_ShouldMoveElementsIntoItsArena)
+{
+    Arena first;
+    Arena second;
+    Array<std::string, ArenaAllocator<std::string>> destination{
+        ArenaAllocator<std::string>(first)};
+    Array<std::string, ArenaAllocator<std::string>> source{ArenaAllocator<std::string>(second)};
+    source.pushBack("a string long enough to live on the heap");
+    source.pushBack("b");
+
+    destination = std::move(source);
+    second.release();
+
+    EXPECT_TRUE(destination.getAllocator() == ArenaAllocator<std::string>(first));
+    EXPECT_TRUE(source.isEmpty());
+    ASSERT_EQ(destination.size(), 2u);
+    EXPECT_EQ(destination[0], "a string long enough to live on the heap");
+    EXPECT_EQ(destination[1], "b");
+}
+TEST(ArenaAllocatorTest, moveAssignment_WhenSourceUsesSameArena_ShouldTakeTheBuffer)
+{
+    Arena arena;
+    Array<int, ArenaAllocator<int>> destination{ArenaAllocator<int>(arena)};
+    Array<int, ArenaAllocator<int>> source{ArenaAllocator<int>(arena)};
+    source.pushBack(1);
+    const int* data = source.data();
+
+    destination = std::move(source);
+
+    EXPECT_EQ(destination.data(), data);
+    EXPECT_EQ(source.data(), nullptr);
+}
+TEST(ArenaAllocatorTest, swap_WhenBothUseSameArena_ShouldExchangeElements)
+{
+    Arena arena;
+    Array<int, ArenaAllocator<int>> first{ArenaAllocator<int>(arena)};
+    Array<int, ArenaAllocator<int>> second{ArenaAllocator<int>(arena)};
+    first.pushBack(1);
+    second.pushBack(2);
+    second.pushBack(3);
+
+    first.swap(second);
+
+    EXPECT_EQ(first.size(), 2u);
+    EXPECT_EQ(second[0], 1);
+}
+
+// --- HugePageAllocator ---
+TEST(HugePageAllocatorTest, allocate_WhenLarge_ShouldAlignToHugePage)
+{
+    HugePageAllocator<int> allocator;
+    size_t n = HugePageAllocator<int>::HUGE_PAGE_SIZE / sizeof(int) + 1;
+
+    int* data = allocator.allocate(n);
+    data[n - 1] = 1;
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % HugePageAllocator<int>::HUGE_PAGE_SIZE, 0u);
+    allocator.deallocate(data, n);
+}
+TEST(HugePageAllocatorTest, pushBack_WhenGrowingPastHugePage_ShouldPreserveElements)
+{
+    Array<int, HugePageAllocator<int>> values;
+    for (int i = 0; i < 1000000; i++)
+    {
+        values.pushBack(i);
+    }
+
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(values[999999], 999999);
+}
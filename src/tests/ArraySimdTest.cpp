@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "ArraySimd.h"
+
+using ds::Array;
+
+template <typename T>
+class ArraySimdTest : public ::testing::Test
+{
+  protected:
+    // Odd sizes exercise the scalar tails after the vector loops.
+    void fill(size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            array.pushBack(static_cast<T>((i * 7919) % 100));
+        }
+    }
+
+    Array<T> array;
+};
+
+using ArithmeticTypes = ::testing::Types<int32_t, float, double, int64_t, uint8_t>;
+TYPED_TEST_SUITE(ArraySimdTest, ArithmeticTypes);
+
+TYPED_TEST(ArraySimdTest, find_WhenValuePresent_ShouldReturnFirstIndex)
+{
+    this->fill(1003);
+    TypeParam value = this->array[777];
+
+    size_t expected = 0;
+    while (this->array[expected] != value)
+    {
+        expected++;
+    }
+
+    EXPECT_EQ(ds::find(this->array, value), expected);
+}
+TYPED_TEST(ArraySimdTest, find_WhenValueAbsent_ShouldReturnSize)
+{
+    this->fill(1003);
+
+    EXPECT_EQ(ds::find(this->array, static_cast<TypeParam>(120)), this->array.size());
+}
+TYPED_TEST(ArraySimdTest, count_WhenCalled_ShouldMatchScalarLoop)
+{
+    this->fill(1003);
+    TypeParam value = this->array[10];
+
+    size_t expected = 0;
+    for (auto it = this->array.cbegin(); it != this->array.cend(); ++it)
+    {
+        expected += *it == value;
+    }
+
+    EXPECT_EQ(ds::count(this->array, value), expected);
+}
+TYPED_TEST(ArraySimdTest, sum_WhenCalled_ShouldMatchScalarLoop)
+{
+    this->fill(1003);
+
+    ds::SumType<TypeParam> expected = 0;
+    for (auto it = this->array.cbegin(); it != this->array.cend(); ++it)
+    {
+        expected += *it;
+    }
+
+    EXPECT_EQ(ds::sum(this->array), expected);
+}
+TYPED_TEST(ArraySimdTest, minMax_WhenCalled_ShouldReturnExtremes)
+{
+    this->fill(1003);
+
+    TypeParam min = this->array[0];
+    TypeParam max = this->array[0];
+    for (auto it = this->array.cbegin(); it != this->array.cend(); ++it)
+    {
+        min = *it < min ? *it : min;
+        max = *it > max ? *it : max;
+    }
+
+    auto result = ds::minMax(this->array);
+    EXPECT_EQ(result.first, min);
+    EXPECT_EQ(result.second, max);
+}
+TYPED_TEST(ArraySimdTest, minMax_WhenEmpty_ShouldThrow)
+{
+    EXPECT_ANY_THROW(ds::minMax(this->array));
+}
+TYPED_TEST(ArraySimdTest, filterInto_WhenCalled_ShouldAppendGreaterElementsInOrder)
+{
+    this->fill(1003);
+    Array<TypeParam> filtered;
+    filtered.pushBack(static_cast<TypeParam>(1));
+    TypeParam threshold = static_cast<TypeParam>(50);
+
+    size_t written = ds::filterInto(this->array, threshold, filtered);
+
+    size_t j = 1;
+    for (auto it = this->array.cbegin(); it != this->array.cend(); ++it)
+    {
+        if (*it > threshold)
+        {
+            ASSERT_EQ(filtered[j++], *it);
+        }
+    }
+    EXPECT_EQ(written, j - 1);
+    EXPECT_EQ(filtered.size(), j);
+}
+TEST(ArraySimdFilterTest, filterInto_WhenAllocatorCannotReallocate_ShouldGrowGeometrically)
+{
+    ds::Arena arena;
+    Array<int32_t> source;
+    for (int32_t i = 0; i < 100000; i++)
+    {
+        source.pushBack(i);
+    }
+    Array<int32_t, ds::ArenaAllocator<int32_t>> filtered{ds::ArenaAllocator<int32_t>(arena)};
+
+    size_t written = ds::filterInto(source, int32_t{-1}, filtered);
+
+    EXPECT_EQ(written, source.size());
+    EXPECT_EQ(filtered[99999], 99999);
+    // Growing to the exact size of every block would use over ten times as much.
+    EXPECT_LE(arena.bytesUsed(), 4 * source.size() * sizeof(int32_t));
+}
+TEST(ArraySimdFilterTest, filterInto_WhenCalledRepeatedly_ShouldGrowGeometrically)
+{
+    ds::Arena arena;
+    Array<int32_t> source;
+    for (int32_t i = 0; i < 1000; i++)
+    {
+        source.pushBack(i);
+    }
+    Array<int32_t, ds::ArenaAllocator<int32_t>> filtered{ds::ArenaAllocator<int32_t>(arena)};
+
+    for (int call = 0; call < 200; call++)
+    {
+        ds::filterInto(source, int32_t{-1}, filtered);
+    }
+
+    EXPECT_EQ(filtered.size(), 200000u);
+    // Reallocating to the exact size on every call would use about a hundred times as much.
+    EXPECT_LE(arena.bytesUsed(), 4 * filtered.size() * sizeof(int32_t));
+}
+TEST(ArraySimdFilterTest, filterInto_WhenFewElementsPass_ShouldOnlyAllocateForThem)
+{
+    Array<int32_t> source;
+    for (int32_t i = 0; i < 100000; i++)
+    {
+        source.pushBack(i);
+    }
+    Array<int32_t> filtered;
+
+    ds::filterInto(source, int32_t{99989}, filtered);
+
+    EXPECT_EQ(filtered.size(), 10u);
+    EXPECT_LE(filtered.capacity(), 32u);
+}
+
+#if DS_SIMD_X86
+TEST(ArraySimdKernelsTest, kernels_WhenSse2OrAvx2_ShouldAgreeWithScalar)
+{
+    Array<int32_t> values;
+    for (int32_t i = 0; i < 1001; i++)
+    {
+        values.pushBack((i * 31) % 257 - 128);
+    }
+    const int32_t* data = values.data();
+    size_t n = values.size();
+    using Scalar = ds::simd::ScalarKernels<int32_t>;
+
+    EXPECT_EQ(ds::simd::sse2::find(data, n, 100), Scalar::find(data, n, 100));
+    EXPECT_EQ(ds::simd::sse2::count(data, n, 100), Scalar::count(data, n, 100));
+    EXPECT_EQ(ds::simd::sse2::sum(data, n), Scalar::sum(data, n));
+    int32_t min = data[0];
+    int32_t max = data[0];
+    ds::simd::sse2::minMax(data, n, min, max);
+    EXPECT_EQ(min, -128);
+    EXPECT_EQ(max, 128);
+    if (ds::simd::hasAvx2())
+    {
+        EXPECT_EQ(ds::simd::avx2::find(data, n, 100), Scalar::find(data, n, 100));
+        EXPECT_EQ(ds::simd::avx2::count(data, n, 100), Scalar::count(data, n, 100));
+        EXPECT_EQ(ds::simd::avx2::sum(data, n), Scalar::sum(data, n));
+    }
+}
+#endif
@@ -1,5 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "Array.h"
 
 using ds::Array;
@@ -131,6 +140,106 @@ TEST_F(ArrayTest, Reserve_WhenCalled_ShouldPreserveElements)
     array.reserve(128);
     EXPECT_EQ(array[0], 0);
 }
+TEST_F(ArrayTest, ShrinkToFit_WhenCapacityExceedsSize_ShouldMatchSize)
+{
+    array.reserve(128);
+    array.pushBack(1);
+    array.pushBack(2);
+
+    array.shrinkToFit();
+
+    EXPECT_EQ(array.capacity(), 2);
+    EXPECT_EQ(array[0], 1);
+    EXPECT_EQ(array[1], 2);
+}
+TEST_F(ArrayTest, ShrinkToFit_WhenEmpty_ShouldReleaseBuffer)
+{
+    array.reserve(128);
+
+    array.shrinkToFit();
+
+    EXPECT_EQ(array.capacity(), 0);
+    EXPECT_EQ(array.data(), nullptr);
+}
+TEST_F(ArrayTest, ShrinkToFit_WhenElementsAreNotTriviallyCopyable_ShouldKeepElements)
+{
+    Array<std::string> strings;
+    strings.reserve(64);
+    strings.pushBack("a");
+    strings.pushBack("b");
+
+    strings.shrinkToFit();
+
+    EXPECT_EQ(strings.capacity(), 2);
+    EXPECT_EQ(strings[1], "b");
+}
+
+// --- Growth policies ---
+TEST_F(ArrayTest, PushBack_WhenDefaultPolicy_ShouldDoubleCapacity)
+{
+    for (int i = 0; i < 33; i++)
+    {
+        array.pushBack(i);
+    }
+    EXPECT_EQ(array.capacity(), 64);
+}
+TEST_F(ArrayTest, PushBack_WhenOneAndHalfGrowth_ShouldGrowByHalf)
+{
+    Array<int, ds::HeapAllocator<int>, ds::OneAndHalfGrowth> values;
+    for (int i = 0; i < 49; i++)
+    {
+        values.pushBack(i);
+    }
+
+    EXPECT_EQ(values.capacity(), 72);
+    EXPECT_EQ(values[48], 48);
+}
+TEST_F(ArrayTest, PushBack_WhenFixedGrowth_ShouldGrowByIncrement)
+{
+    Array<int, ds::HeapAllocator<int>, ds::FixedGrowth<10>> values;
+    for (int i = 0; i < 25; i++)
+    {
+        values.pushBack(i);
+    }
+
+    EXPECT_EQ(values.capacity(), 30);
+    EXPECT_EQ(values[24], 24);
+}
+TEST_F(ArrayTest, PushBack_WhenFunctorPolicy_ShouldUseIt)
+{
+    using Policy = std::function<size_t(size_t)>;
+    Array<int, ds::HeapAllocator<int>, Policy> values(ds::HeapAllocator<int>(),
+                                                      [](size_t capacity) { return capacity + 3; });
+    for (int i = 0; i < 7; i++)
+    {
+        values.pushBack(i);
+    }
+
+    EXPECT_EQ(values.capacity(), 9);
+}
+TEST_F(ArrayTest, PushBack_WhenPolicyDoesNotGrow_ShouldStillAddElements)
+{
+    using Policy = std::function<size_t(size_t)>;
+    Array<int, ds::HeapAllocator<int>, Policy> values(ds::HeapAllocator<int>(),
+                                                      [](size_t capacity) { return capacity; });
+    for (int i = 0; i < 3; i++)
+    {
+        values.pushBack(i);
+    }
+
+    EXPECT_EQ(values.size(), 3);
+    EXPECT_EQ(values[2], 2);
+}
+TEST_F(ArrayTest, Append_WhenGrowthPolicyIsSmallerThanRange_ShouldFitRange)
+{
+    Array<int, ds::HeapAllocator<int>, ds::FixedGrowth<1>> values;
+    int range[] = {1, 2, 3, 4, 5};
+
+    values.append(range, range + 5);
+
+    EXPECT_EQ(values.capacity(), 5);
+    EXPECT_EQ(values[4], 5);
+}
 
 // --- Clear ---
 TEST_F(ArrayTest, Clear_WhenArrayNotEmpty_ShouldResetAll)
@@ -217,4 +326,420 @@ TEST_F(ArrayTest, IteratorLoop_WhenReverseIterating_ShouldVisitAllElementsInReve
     {
         EXPECT_EQ(*it, i);
     }
-}
\ No newline at end of file
+}
+
+// --- Element construction ---
+namespace
+{
+struct Tracked
+{
+    static int constructions;
+    static int destructions;
+
+    explicit Tracked(int iValue = 0) : value(iValue)
+    {
+        ++constructions;
+    }
+    Tracked(const Tracked& other) : value(other.value)
+    {
+        ++constructions;
+    }
+    Tracked(Tracked&& other) noexcept : value(other.value)
+    {
+        ++constructions;
+    }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+    ~Tracked()
+    {
+        ++destructions;
+    }
+
+    int value;
+};
+
+int Tracked::constructions = 0;
+int Tracked::destructions = 0;
+} // namespace
+
+TEST(ArrayConstructionTest, Reserve_WhenCalled_ShouldNotConstructElements)
+{
+    Tracked::constructions = 0;
+
+    Array<Tracked> tracked;
+    tracked.reserve(64);
+
+    EXPECT_EQ(Tracked::constructions, 0);
+}
+TEST(ArrayConstructionTest, EmplaceBack_WhenCalled_ShouldConstructInPlace)
+{
+    Array<Tracked> tracked;
+    tracked.reserve(4);
+    Tracked::constructions = 0;
+
+    Tracked& element = tracked.emplaceBack(7);
+
+    EXPECT_EQ(Tracked::constructions, 1);
+    EXPECT_EQ(element.value, 7);
+    EXPECT_EQ(tracked.size(), 1u);
+}
+TEST(ArrayConstructionTest, PushBack_WhenGrowing_ShouldOnlyMoveLiveElements)
+{
+    Array<Tracked> tracked;
+    tracked.reserve(2);
+    tracked.emplaceBack(0);
+    tracked.emplaceBack(1);
+    Tracked::constructions = 0;
+
+    tracked.emplaceBack(2);
+
+    EXPECT_EQ(Tracked::constructions, 3);
+    EXPECT_EQ(tracked[0].value, 0);
+    EXPECT_EQ(tracked[2].value, 2);
+}
+TEST(ArrayConstructionTest, PushBack_WhenElementAliasesArray_ShouldCopyBeforeGrowing)
+{
+    Array<std::string> strings;
+    strings.reserve(1);
+    strings.pushBack("first");
+
+    strings.pushBack(strings[0]);
+
+    EXPECT_EQ(strings[1], "first");
+}
+TEST(ArrayConstructionTest, PushBack_WhenRvalue_ShouldMoveElement)
+{
+    Array<std::string> strings;
+    std::string value(100, 'x');
+
+    strings.pushBack(std::move(value));
+
+    EXPECT_EQ(strings[0], std::string(100, 'x'));
+    EXPECT_TRUE(value.empty());
+}
+TEST(ArrayConstructionTest, Destructor_WhenCalled_ShouldDestroyEveryLiveElement)
+{
+    Tracked::constructions = 0;
+    Tracked::destructions = 0;
+    {
+        Array<Tracked> tracked;
+        for (int i = 0; i < 40; i++)
+        {
+            tracked.emplaceBack(i);
+        }
+        tracked.popBack();
+    }
+
+    EXPECT_EQ(Tracked::constructions, Tracked::destructions);
+}
+TEST(ArrayConstructionTest, Resize_WhenShrinking_ShouldDestroyTrailingElements)
+{
+    Array<Tracked> tracked;
+    tracked.resize(4);
+    Tracked::destructions = 0;
+
+    tracked.resize(1);
+
+    EXPECT_EQ(Tracked::destructions, 3);
+    EXPECT_EQ(tracked.size(), 1u);
+}
+
+// --- Trivially relocatable types ---
+namespace
+{
+struct Relocatable
+{
+    std::unique_ptr<int> value;
+};
+} // namespace
+
+namespace ds
+{
+template <>
+struct IsTriviallyRelocatable<Relocatable> : std::true_type
+{
+};
+} // namespace ds
+
+TEST(ArrayRelocationTest, PushBack_WhenTriviallyCopyable_ShouldPreserveElementsAcrossGrowth)
+{
+    Array<uint64_t> values;
+    for (uint64_t i = 0; i < 100000; i++)
+    {
+        values.pushBack(i * 3);
+    }
+
+    for (uint64_t i = 0; i < 100000; i++)
+    {
+        ASSERT_EQ(values[i], i * 3);
+    }
+}
+TEST(ArrayRelocationTest, PushBack_WhenOptedInAsRelocatable_ShouldPreserveElementsAcrossGrowth)
+{
+    Array<Relocatable> values;
+    for (int i = 0; i < 100; i++)
+    {
+        values.pushBack(Relocatable{std::unique_ptr<int>(new int(i))});
+    }
+
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(*values[i].value, i);
+    }
+}
+TEST(ArrayRelocationTest, PushBack_WhenElementAliasesArray_ShouldCopyBeforeGrowing)
+{
+    Array<double> values;
+    values.reserve(1);
+    values.pushBack(1.5);
+
+    values.pushBack(values[0]);
+
+    EXPECT_EQ(values[1], 1.5);
+}
+TEST(ArrayRelocationTest, CopyAssignment_WhenCapacitySuffices_ShouldReuseBuffer)
+{
+    Array<int> source;
+    source.pushBack(1);
+    source.pushBack(2);
+    Array<int> target;
+    target.reserve(64);
+
+    target = source;
+
+    EXPECT_EQ(target.capacity(), 64u);
+    EXPECT_EQ(target.size(), 2u);
+    EXPECT_EQ(target[1], 2);
+}
+TEST(ArrayRelocationTest, Resize_WhenTriviallyCopyable_ShouldZeroNewElements)
+{
+    Array<int> values;
+    values.pushBack(5);
+
+    values.resize(10);
+
+    EXPECT_EQ(values[0], 5);
+    EXPECT_EQ(values[9], 0);
+}
+
+// --- Range operations ---
+TEST_F(ArrayTest, Append_WhenRangeExceedsCapacity_ShouldGrowOnce)
+{
+    std::vector<int> values(100);
+    for (int i = 0; i < 100; i++)
+    {
+        values[i] = i;
+    }
+    array.pushBack(-1);
+
+    array.append(values.begin(), values.end());
+
+    EXPECT_EQ(array.size(), 101u);
+    EXPECT_EQ(array.capacity(), 101u);
+    EXPECT_EQ(array[0], -1);
+    EXPECT_EQ(array[100], 99);
+}
+TEST_F(ArrayTest, Append_WhenInputIterators_ShouldAppendAllElements)
+{
+    std::istringstream stream("1 2 3");
+
+    array.append(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+
+    EXPECT_EQ(array.size(), 3u);
+    EXPECT_EQ(array[2], 3);
+}
+TEST_F(ArrayTest, Insert_WhenInMiddle_ShouldShiftFollowingElements)
+{
+    int values[] = {10, 11};
+    array.reserve(8);
+    for (int i = 0; i < 4; i++)
+    {
+        array.pushBack(i);
+    }
+
+    auto it = array.insert(++array.begin(), values, values + 2);
+
+    EXPECT_EQ(*it, 10);
+    int expected[] = {0, 10, 11, 1, 2, 3};
+    ASSERT_EQ(array.size(), 6u);
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(array[i], expected[i]);
+    }
+}
+TEST_F(ArrayTest, Insert_WhenGrowing_ShouldKeepOrder)
+{
+    std::string values[] = {"b", "c"};
+    Array<std::string> strings;
+    strings.reserve(2);
+    strings.pushBack("a");
+    strings.pushBack("d");
+
+    strings.insert(++strings.begin(), values, values + 2);
+
+    ASSERT_EQ(strings.size(), 4u);
+    EXPECT_EQ(strings[0], "a");
+    EXPECT_EQ(strings[1], "b");
+    EXPECT_EQ(strings[2], "c");
+    EXPECT_EQ(strings[3], "d");
+}
+TEST_F(ArrayTest, Insert_WhenNotRelocatableAndInPlace_ShouldKeepOrder)
+{
+    std::string values[] = {"b", "c"};
+    Array<std::string> strings;
+    strings.reserve(8);
+    strings.pushBack("a");
+    strings.pushBack("d");
+
+    strings.insert(++strings.begin(), values, values + 2);
+
+    ASSERT_EQ(strings.size(), 4u);
+    EXPECT_EQ(strings[1], "b");
+    EXPECT_EQ(strings[3], "d");
+}
+TEST_F(ArrayTest, Erase_WhenRangeInMiddle_ShouldCloseTheGap)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        array.pushBack(i);
+    }
+    auto first = ++array.begin();
+    auto last = first;
+    ++last;
+    ++last;
+
+    auto it = array.erase(first, last);
+
+    EXPECT_EQ(*it, 3);
+    int expected[] = {0, 3, 4, 5};
+    ASSERT_EQ(array.size(), 4u);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(array[i], expected[i]);
+    }
+}
+TEST_F(ArrayTest, Erase_WhenNotRelocatable_ShouldCloseTheGap)
+{
+    Array<std::string> strings;
+    strings.pushBack("a");
+    strings.pushBack("b");
+    strings.pushBack("c");
+
+    strings.erase(strings.begin(), ++strings.begin());
+
+    ASSERT_EQ(strings.size(), 2u);
+    EXPECT_EQ(strings[0], "b");
+    EXPECT_EQ(strings[1], "c");
+}
+TEST_F(ArrayTest, Assign_WhenLargerThanCapacity_ShouldReplaceContents)
+{
+    array.pushBack(1);
+
+    array.assign(50, 7);
+
+    EXPECT_EQ(array.size(), 50u);
+    EXPECT_EQ(array.capacity(), 50u);
+    EXPECT_EQ(array[49], 7);
+}
+TEST_F(ArrayTest, Assign_WhenSmallerThanSize_ShouldShrink)
+{
+    Array<std::string> strings;
+    strings.pushBack("a");
+    strings.pushBack("b");
+    strings.pushBack("c");
+
+    strings.assign(1, "z");
+
+    ASSERT_EQ(strings.size(), 1u);
+    EXPECT_EQ(strings[0], "z");
+}
+
+// --- Random access iterators ---
+TEST_F(ArrayTest, Iterator_WhenUsedWithSort_ShouldSortInPlace)
+{
+    int values[] = {5, 3, 9, 1, 7};
+    array.append(values, values + 5);
+
+    std::sort(array.begin(), array.end());
+
+    int expected[] = {1, 3, 5, 7, 9};
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(array[i], expected[i]);
+    }
+}
+TEST_F(ArrayTest, Iterator_WhenUsedWithLowerBound_ShouldFindPosition)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        array.pushBack(i * 2);
+    }
+
+    auto it = std::lower_bound(array.cbegin(), array.cend(), 7);
+
+    EXPECT_EQ(it - array.cbegin(), 4);
+    EXPECT_EQ(*it, 8);
+}
+TEST_F(ArrayTest, Iterator_WhenUsedWithNthElement_ShouldPartition)
+{
+    for (int i = 9; i >= 0; i--)
+    {
+        array.pushBack(i);
+    }
+
+    std::nth_element(array.begin(), array.begin() + 3, array.end());
+
+    EXPECT_EQ(array[3], 3);
+}
+TEST_F(ArrayTest, Iterator_WhenUsingArithmetic_ShouldBehaveLikePointers)
+{
+    for (int i = 0; i < 5; i++)
+    {
+        array.pushBack(i);
+    }
+
+    auto it = array.begin();
+    it += 3;
+
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(it[1], 4);
+    EXPECT_EQ(*(it - 2), 1);
+    EXPECT_EQ(*(1 + array.begin()), 1);
+    EXPECT_EQ(array.end() - array.begin(), 5);
+    EXPECT_TRUE(array.begin() < it);
+    EXPECT_TRUE(it >= array.begin());
+}
+TEST_F(ArrayTest, Iterator_WhenConvertedToConstIterator_ShouldPointToSameElement)
+{
+    array.pushBack(4);
+
+    Array<int>::ConstIterator it = array.begin();
+
+    EXPECT_EQ(*it, 4);
+    EXPECT_TRUE(it == array.cbegin());
+}
+TEST_F(ArrayTest, Iterator_WhenArrayIsConst_ShouldSupportRangeFor)
+{
+    array.pushBack(1);
+    array.pushBack(2);
+    const Array<int>& constArray = array;
+
+    int total = 0;
+    for (int value : constArray)
+    {
+        total += value;
+    }
+
+    EXPECT_EQ(total, 3);
+}
+TEST_F(ArrayTest, Append_WhenRangeIsAnotherArray_ShouldCopyElements)
+{
+    Array<int> source;
+    source.pushBack(1);
+    source.pushBack(2);
+
+    array.append(source.cbegin(), source.cend());
+
+    EXPECT_EQ(array.size(), 2u);
+    EXPECT_EQ(array[1], 2);
+}
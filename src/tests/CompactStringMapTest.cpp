@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "CompactStringMap.h"
+#include "HashMap.h"
+
+using ds::CompactStringMap;
+
+class CompactStringMapTest : public ::testing::Test
+{
+  protected:
+    CompactStringMap<std::string> map;
+};
+
+TEST_F(CompactStringMapTest, constructor_ShouldConstructEmptyMap)
+{
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_THROW(map.at("Alice"), std::out_of_range);
+    EXPECT_EQ(map.find("Alice"), nullptr);
+}
+
+TEST_F(CompactStringMapTest, subscriptOperator_ShouldInsertAndUpdateValues)
+{
+    map["Alice"] = "Engineer";
+    map[std::string("Alice")] = "Manager";
+    map["Bob"] = "Lawyer";
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at("Alice"), "Manager");
+    EXPECT_EQ(*map.find(std::string("Bob")), "Lawyer");
+}
+
+TEST_F(CompactStringMapTest, insert_WhenKeyExists_ShouldThrow)
+{
+    map.insert("Alice", "Engineer");
+
+    EXPECT_THROW(map.insert("Alice", "Manager"), std::runtime_error);
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+}
+
+TEST_F(CompactStringMapTest, insertOrAssign_ShouldReportWhetherKeyWasNew)
+{
+    EXPECT_TRUE(map.insertOrAssign("Alice", "Engineer"));
+    EXPECT_FALSE(map.insertOrAssign("Alice", "Manager"));
+
+    EXPECT_EQ(map.at("Alice"), "Manager");
+}
+
+TEST_F(CompactStringMapTest, erase_ShouldRemoveOnlyGivenKey)
+{
+    map["Alice"] = "Engineer";
+    map["Bob"] = "Lawyer";
+
+    map.erase("Alice");
+    map.erase("Carol");
+
+    EXPECT_FALSE(map.contains("Alice"));
+    EXPECT_TRUE(map.contains("Bob"));
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(CompactStringMapTest, keys_WhenLongOrContainingNullBytes_ShouldBeKeptExactly)
+{
+    std::string longKey(1000, 'k');
+    std::string withNull("a\0b", 3);
+
+    map[longKey] = "long";
+    map[withNull] = "null";
+
+    EXPECT_EQ(map.at(longKey), "long");
+    EXPECT_EQ(map.at(withNull), "null");
+    EXPECT_FALSE(map.contains("a"));
+}
+
+TEST_F(CompactStringMapTest, manyKeys_ShouldMatchReferenceMap)
+{
+    CompactStringMap<int> numbers;
+    std::map<std::string, int> reference;
+    for (int i = 0; i < 20000; i++)
+    {
+        std::string key = "user:" + std::to_string(i * 7 % 5000);
+        numbers[key] += i;
+        reference[key] += i;
+    }
+    for (int i = 0; i < 5000; i += 3)
+    {
+        std::string key = "user:" + std::to_string(i);
+        numbers.erase(key);
+        reference.erase(key);
+    }
+
+    ASSERT_EQ(numbers.size(), reference.size());
+    for (const auto& entry : reference)
+    {
+        ASSERT_EQ(numbers.at(entry.first), entry.second);
+    }
+}
+
+TEST_F(CompactStringMapTest, iteration_ShouldVisitEveryEntryOnce)
+{
+    map["Alice"] = "Engineer";
+    map["Bob"] = "Lawyer";
+    map["Carol"] = "Doctor";
+
+    std::map<std::string, std::string> seen;
+    for (auto entry : map)
+    {
+        seen[entry.first.str()] = entry.second;
+        entry.second += "!";
+    }
+
+    EXPECT_EQ(seen.size(), 3);
+    EXPECT_EQ(seen["Bob"], "Lawyer");
+    EXPECT_EQ(map.at("Bob"), "Lawyer!");
+}
+
+TEST_F(CompactStringMapTest, constIteration_ShouldExposeKeysAndValues)
+{
+    map["Alice"] = "Engineer";
+    const CompactStringMap<std::string>& constMap = map;
+
+    auto it = constMap.cbegin();
+
+    ASSERT_NE(it, constMap.cend());
+    EXPECT_EQ(it.key().str(), "Alice");
+    EXPECT_EQ(it.value(), "Engineer");
+    EXPECT_EQ(++it, constMap.cend());
+}
+
+TEST_F(CompactStringMapTest, copyConstructor_ShouldCopyIndependently)
+{
+    map["Alice"] = "Engineer";
+
+    CompactStringMap<std::string> copy(map);
+    copy["Bob"] = "Lawyer";
+    map["Alice"] = "Manager";
+
+    EXPECT_EQ(copy.at("Alice"), "Engineer");
+    EXPECT_FALSE(map.contains("Bob"));
+    EXPECT_EQ(copy.size(), 2);
+}
+
+TEST_F(CompactStringMapTest, moveConstructor_ShouldLeaveSourceEmptyAndUsable)
+{
+    map["Alice"] = "Engineer";
+
+    CompactStringMap<std::string> moved(std::move(map));
+    map["Bob"] = "Lawyer";
+
+    EXPECT_EQ(moved.at("Alice"), "Engineer");
+    EXPECT_FALSE(map.contains("Alice"));
+    EXPECT_EQ(map.at("Bob"), "Lawyer");
+}
+
+TEST_F(CompactStringMapTest, copyAssignment_ShouldReplaceContent)
+{
+    CompactStringMap<std::string> other;
+    other["Bob"] = "Lawyer";
+    map["Alice"] = "Engineer";
+
+    map = other;
+    other["Carol"] = "Doctor";
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at("Bob"), "Lawyer");
+    EXPECT_FALSE(map.contains("Carol"));
+}
+
+TEST_F(CompactStringMapTest, compact_ShouldReleaseBytesOfErasedKeys)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        map["key:" + std::to_string(i)] = std::to_string(i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        map.erase("key:" + std::to_string(i));
+    }
+    size_t before = map.statistics().memoryBytes;
+
+    map.compact();
+
+    EXPECT_LT(map.statistics().memoryBytes, before);
+    EXPECT_EQ(map.size(), 500);
+    for (int i = 1; i < 1000; i += 2)
+    {
+        ASSERT_EQ(map.at("key:" + std::to_string(i)), std::to_string(i));
+    }
+    map["key:0"] = "0";
+    EXPECT_EQ(map.at("key:0"), "0");
+}
+
+TEST_F(CompactStringMapTest, statistics_ShouldUseLessMemoryThanHashMapOfStrings)
+{
+    CompactStringMap<int> compact;
+    ds::HashMap<std::string, int> strings;
+    for (int i = 0; i < 10000; i++)
+    {
+        std::string key = "user:" + std::to_string(i);
+        compact[key] = i;
+        strings[key] = i;
+    }
+
+    ds::HashTableStats stats = compact.statistics();
+
+    EXPECT_EQ(stats.size, 10000);
+    EXPECT_LT(stats.memoryBytes * 2, strings.statistics().memoryBytes);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentHashMap.h"
+
+using ds::ConcurrentHashMap;
+
+namespace
+{
+struct CountingHash
+{
+    static int calls;
+
+    size_t operator()(const std::string& key) const
+    {
+        ++calls;
+        return ds::Hash<std::string>()(key);
+    }
+};
+int CountingHash::calls = 0;
+} // namespace
+
+class ConcurrentHashMapTest : public ::testing::Test
+{
+  protected:
+    ConcurrentHashMap<int, int> map{8};
+};
+
+TEST_F(ConcurrentHashMapTest, Constructor_WhenCalled_ShouldRoundSegmentsToPowerOfTwo)
+{
+    ConcurrentHashMap<int, int> other(10);
+
+    EXPECT_EQ(other.segmentCount(), 16u);
+    EXPECT_TRUE(other.isEmpty());
+}
+TEST_F(ConcurrentHashMapTest, Insert_WhenKeyIsNew_ShouldStoreValue)
+{
+    map.insert(std::pair<const int, int>(1, 10));
+
+    EXPECT_EQ(map.at(1), 10);
+    EXPECT_EQ(map.size(), 1u);
+}
+TEST_F(ConcurrentHashMapTest, Insert_WhenKeyExists_ShouldThrow)
+{
+    map.insert(std::pair<const int, int>(1, 10));
+
+    EXPECT_THROW(map.insert(std::pair<const int, int>(1, 20)), std::runtime_error);
+    EXPECT_EQ(map.at(1), 10);
+}
+TEST_F(ConcurrentHashMapTest, At_WhenKeyIsMissing_ShouldThrowOutOfRange)
+{
+    EXPECT_THROW(map.at(1), std::out_of_range);
+}
+TEST_F(ConcurrentHashMapTest, InsertOrAssign_WhenCalled_ShouldReportWhetherKeyWasNew)
+{
+    EXPECT_TRUE(map.insertOrAssign(1, 10));
+    EXPECT_FALSE(map.insertOrAssign(1, 20));
+
+    EXPECT_EQ(map.at(1), 20);
+}
+TEST_F(ConcurrentHashMapTest, ComputeIfAbsent_WhenKeyExists_ShouldNotCallFunction)
+{
+    map.insert(std::pair<const int, int>(1, 10));
+
+    int value = map.computeIfAbsent(1, [](int) -> int { throw std::logic_error("called"); });
+
+    EXPECT_EQ(value, 10);
+}
+TEST_F(ConcurrentHashMapTest, ComputeIfAbsent_WhenFunctionThrows_ShouldLeaveKeyAbsent)
+{
+    EXPECT_THROW(map.computeIfAbsent(1, [](int) -> int { throw std::logic_error("failed"); }),
+                 std::logic_error);
+
+    EXPECT_TRUE(map.isEmpty());
+}
+TEST_F(ConcurrentHashMapTest, Erase_WhenCalled_ShouldReportWhetherKeyWasPresent)
+{
+    map.insert(std::pair<const int, int>(1, 10));
+
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_TRUE(map.isEmpty());
+}
+TEST_F(ConcurrentHashMapTest, Clear_WhenCalled_ShouldEmptyAllSegments)
+{
+    for (int i = 0; i < 100; i++)
+    {
+        map.insertOrAssign(i, i);
+    }
+
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+}
+TEST_F(ConcurrentHashMapTest, ComputeIfAbsent_WhenCalledConcurrently_ShouldComputeEachKeyOnce)
+{
+    std::atomic<int> calls{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++)
+    {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; i++)
+            {
+                map.computeIfAbsent(i, [&](int key) {
+                    calls++;
+                    return key * 2;
+                });
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(calls.load(), 1000);
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_EQ(map.at(999), 1998);
+}
+TEST_F(ConcurrentHashMapTest, Operations_WhenMixedAcrossThreads_ShouldKeepCountsConsistent)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 5000; i++)
+            {
+                int key = t * 5000 + i;
+                map.insertOrAssign(key, i);
+                EXPECT_EQ(map.at(key), i);
+                if (i % 2 == 0)
+                {
+                    EXPECT_TRUE(map.erase(key));
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(map.size(), 10000u);
+}
+TEST_F(ConcurrentHashMapTest, At_WhenKeyIsString_ShouldUseStringHasher)
+{
+    ConcurrentHashMap<std::string, std::string> strings;
+
+    strings.insertOrAssign("Alice", "Engineer");
+
+    EXPECT_EQ(strings.at("Alice"), "Engineer");
+}
+TEST_F(ConcurrentHashMapTest, Operations_WhenCalled_ShouldHashEachKeyOnce)
+{
+    ConcurrentHashMap<std::string, int, CountingHash> strings;
+    CountingHash::calls = 0;
+
+    strings.insertOrAssign("Alice", 1);
+    strings.insert(std::pair<const std::string, int>("Bob", 2));
+    strings.computeIfAbsent("Carol", [](const std::string&) { return 3; });
+    int value = strings.at("Alice");
+    strings.erase("Bob");
+
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(CountingHash::calls, 5);
+    EXPECT_EQ(strings.size(), 2u);
+}
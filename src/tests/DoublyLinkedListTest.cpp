@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "DoublyLinkedList.h"
 
 using ds::DoublyLinkedList;
@@ -219,6 +223,86 @@ TEST_F(DoublyLinkedListTest, Erase_WhenListHasElements_ShouldEraseRightElement)
     EXPECT_EQ(list.popFront(), 2);
 }
 
+// --- Emplace and Splice ---
+TEST_F(DoublyLinkedListTest, EmplaceBack_WhenCalled_ShouldConstructElementInPlace)
+{
+    DoublyLinkedList<std::pair<int, std::string>> pairs;
+
+    auto& pair = pairs.emplaceBack(1, "one");
+
+    EXPECT_EQ(pair.first, 1);
+    EXPECT_EQ(pairs.getBack().second, "one");
+}
+
+TEST_F(DoublyLinkedListTest, PushBack_WhenGivenRvalue_ShouldMoveElement)
+{
+    DoublyLinkedList<std::unique_ptr<int>> pointers;
+
+    pointers.pushBack(std::make_unique<int>(1));
+    pointers.pushFront(std::make_unique<int>(0));
+
+    EXPECT_EQ(*pointers.getFront(), 0);
+    EXPECT_EQ(*pointers.getBack(), 1);
+}
+
+TEST_F(DoublyLinkedListTest, Emplace_WhenGivenMiddlePosition_ShouldInsertBeforeIt)
+{
+    list.pushBack(0);
+    list.pushBack(2);
+    auto it = list.begin();
+    ++it;
+
+    auto inserted = list.emplace(it, 1);
+
+    EXPECT_EQ(*inserted, 1);
+    EXPECT_EQ(list.popFront(), 0);
+    EXPECT_EQ(list.popFront(), 1);
+    EXPECT_EQ(list.popFront(), 2);
+}
+
+TEST_F(DoublyLinkedListTest, Splice_WhenMovingNodeToFront_ShouldKeepElementAddress)
+{
+    list.pushBack(0);
+    list.pushBack(1);
+    list.pushBack(2);
+    auto it = list.rbegin();
+    int* address = &*it;
+
+    list.splice(list.begin(), list, it);
+
+    EXPECT_EQ(&list.getFront(), address);
+    EXPECT_EQ(list.getBack(), 1);
+    EXPECT_EQ(list.popFront(), 2);
+    EXPECT_EQ(list.popFront(), 0);
+    EXPECT_EQ(list.popFront(), 1);
+}
+
+TEST_F(DoublyLinkedListTest, Splice_WhenMovingNodeBetweenLists_ShouldTransferIt)
+{
+    DoublyLinkedList<int> other;
+    other.pushBack(5);
+    list.pushBack(0);
+
+    list.splice(list.end(), other, other.begin());
+
+    EXPECT_TRUE(other.isEmpty());
+    EXPECT_EQ(list.getBack(), 5);
+    EXPECT_EQ(list.popBack(), 5);
+    EXPECT_EQ(list.popBack(), 0);
+}
+
+TEST_F(DoublyLinkedListTest, PopFront_WhenFollowedByPushFront_ShouldKeepLinksConsistent)
+{
+    list.pushBack(0);
+    list.pushBack(1);
+
+    list.popFront();
+    list.pushFront(2);
+
+    EXPECT_EQ(*list.rbegin(), 1);
+    EXPECT_EQ(*--list.rbegin(), 2);
+}
+
 // --- Iterator Behavior ---
 TEST_F(DoublyLinkedListTest, Begin_WhenListIsEmpty_ShouldEqualEnd)
 {
@@ -335,4 +419,19 @@ TEST_F(DoublyLinkedListTest, PushFrontAndPushBack_MixedSequence_ShouldMaintainCo
 
     EXPECT_EQ(list.getFront(), 4);
     EXPECT_EQ(list.getBack(), 3);
-}
\ No newline at end of file
+}
+
+// --- Destructor ---
+TEST_F(DoublyLinkedListTest, Destructor_WhenListIsLong_ShouldNotOverflowStack)
+{
+    {
+        DoublyLinkedList<int> longList;
+        for (int i = 0; i < 1000000; i++)
+        {
+            longList.pushBack(i);
+        }
+    }
+
+    list.pushBack(1);
+    EXPECT_EQ(list.getBack(), 1);
+}
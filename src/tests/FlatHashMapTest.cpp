@@ -0,0 +1,495 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "FlatHashMap.h"
+
+using ds::FlatHashMap;
+
+class FlatHashMapTest : public ::testing::Test
+{
+  protected:
+    FlatHashMap<std::string, std::string> map;
+};
+
+TEST_F(FlatHashMapTest, constructor_ShouldConstructEmptyMap)
+{
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_ANY_THROW(map.at("Alice"));
+}
+
+TEST_F(FlatHashMapTest, copyConstructor_ShouldCopyElementsFromSource)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    FlatHashMap<std::string, std::string> otherMap(map);
+
+    EXPECT_EQ(otherMap.at("Alice"), "Engineer");
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+}
+
+TEST_F(FlatHashMapTest, copyAssignmentOperator_ShouldCopyElementsFromSource)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+    FlatHashMap<std::string, std::string> otherMap;
+    otherMap.insert(std::pair<std::string, std::string>("Bob", "Scientist"));
+
+    otherMap = map;
+
+    EXPECT_EQ(otherMap.at("Alice"), "Engineer");
+    EXPECT_ANY_THROW(otherMap.at("Bob"));
+    EXPECT_EQ(otherMap.size(), 1);
+}
+
+TEST_F(FlatHashMapTest, moveConstructor_ShouldMoveElementsFromSourceAndKeepItValid)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    FlatHashMap<std::string, std::string> otherMap(std::move(map));
+
+    EXPECT_EQ(otherMap.at("Alice"), "Engineer");
+    EXPECT_TRUE(map.isEmpty());
+    map["Bob"] = "Scientist";
+    EXPECT_EQ(map.at("Bob"), "Scientist");
+}
+
+TEST_F(FlatHashMapTest, moveAssignmentOperator_ShouldMoveElementsFromSourceAndKeepItValid)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+    FlatHashMap<std::string, std::string> otherMap;
+
+    otherMap = std::move(map);
+
+    EXPECT_EQ(otherMap.at("Alice"), "Engineer");
+    EXPECT_TRUE(map.isEmpty());
+}
+
+TEST_F(FlatHashMapTest, size_ShouldReturnCurrentSize)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+    map.insert(std::pair<std::string, std::string>("Bob", "Scientist"));
+
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST_F(FlatHashMapTest, at_WhenElementNotPresent_ShouldThrowOutOfRange)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    EXPECT_THROW(map.at("Bob"), std::out_of_range);
+}
+
+TEST_F(FlatHashMapTest, bracketOperator_WhenElementNotPresent_ShouldCreateElement)
+{
+    map["Alice"] = "Engineer";
+
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(FlatHashMapTest, bracketOperator_WhenElementPresent_ShouldReturnValue)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    EXPECT_EQ(map["Alice"], "Engineer");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(FlatHashMapTest, clear_ShouldClearMap)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+    map.insert(std::pair<std::string, std::string>("Bob", "Scientist"));
+
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_ANY_THROW(map.at("Alice"));
+}
+
+TEST_F(FlatHashMapTest, insert_ShouldReturnInsertedValue)
+{
+    auto& value = map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    EXPECT_EQ(value.first, "Alice");
+    EXPECT_EQ(value.second, "Engineer");
+}
+
+TEST_F(FlatHashMapTest, insert_WhenValueAlreadyExists_ShouldThrow)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+    EXPECT_THROW(map.insert(std::pair<std::string, std::string>("Alice", "Lawyer")),
+                 std::runtime_error);
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+}
+
+TEST_F(FlatHashMapTest, insert_WhenManyElements_ShouldGrowAndKeepAllElements)
+{
+    FlatHashMap<int, int> intMap;
+    for (int i = 0; i < 10000; i++)
+    {
+        intMap.insert(std::pair<int, int>(i * 64, i));
+    }
+
+    EXPECT_EQ(intMap.size(), 10000);
+    for (int i = 0; i < 10000; i++)
+    {
+        EXPECT_EQ(intMap.at(i * 64), i);
+    }
+}
+
+TEST_F(FlatHashMapTest, erase_WhenElementExists_ShouldErase)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    map.erase("Alice");
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_ANY_THROW(map.at("Alice"));
+}
+
+TEST_F(FlatHashMapTest, erase_WhenElementMissing_ShouldDoNothing)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    map.erase("Bob");
+
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(FlatHashMapTest, erase_WhenInterleavedWithInserts_ShouldMatchReference)
+{
+    FlatHashMap<int, int> intMap;
+    std::unordered_map<int, int> reference;
+    unsigned state = 12345;
+    for (int i = 0; i < 20000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        int key = static_cast<int>((state >> 8) % 2000);
+        if (state & 1)
+        {
+            intMap.erase(key);
+            reference.erase(key);
+        }
+        else
+        {
+            intMap[key] = i;
+            reference[key] = i;
+        }
+    }
+
+    ASSERT_EQ(intMap.size(), reference.size());
+    for (int key = 0; key < 2000; key++)
+    {
+        auto it = reference.find(key);
+        if (it == reference.end())
+        {
+            EXPECT_ANY_THROW(intMap.at(key));
+        }
+        else
+        {
+            EXPECT_EQ(intMap.at(key), it->second);
+        }
+    }
+}
+
+TEST_F(FlatHashMapTest, resize_ShouldKeepElements)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    map.resize(1000);
+
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(FlatHashMapTest, at_WhenCalledWithStringLiteral_ShouldFindStringKey)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+    EXPECT_THROW(map.at("Bob"), std::out_of_range);
+}
+
+TEST_F(FlatHashMapTest, bracketOperator_WhenCalledWithStringLiteral_ShouldInsertOnce)
+{
+    map["Alice"] = "Engineer";
+    map["Alice"] = "Lawyer";
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at(std::string("Alice")), "Lawyer");
+}
+
+TEST_F(FlatHashMapTest, erase_WhenCalledWithStringLiteral_ShouldErase)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    map.erase("Alice");
+
+    EXPECT_TRUE(map.isEmpty());
+}
+
+namespace
+{
+struct ConstantHash
+{
+    size_t operator()(int) const
+    {
+        return 0;
+    }
+};
+} // namespace
+
+TEST_F(FlatHashMapTest, erase_WhenHasherMapsAllKeysToOneSlot_ShouldShiftFollowingEntries)
+{
+    FlatHashMap<int, int, ConstantHash> intMap;
+    for (int i = 0; i < 10; i++)
+    {
+        intMap.insert(std::pair<int, int>(i, i));
+    }
+
+    intMap.erase(3);
+
+    EXPECT_EQ(intMap.size(), 9);
+    EXPECT_ANY_THROW(intMap.at(3));
+    for (int i = 0; i < 10; i++)
+    {
+        if (i != 3)
+        {
+            EXPECT_EQ(intMap.at(i), i);
+        }
+    }
+}
+
+namespace
+{
+// Sends keys below 100 to one home slot and the others to another, so that a new small key has to
+// displace the entries placed after the first run.
+struct TwoSlotHash
+{
+    size_t operator()(int key) const
+    {
+        return key < 100 ? 0 : 1;
+    }
+};
+
+struct ThrowingValue
+{
+    ThrowingValue() : value(0)
+    {
+        if (throwOnConstruct)
+        {
+            throw std::runtime_error("ThrowingValue");
+        }
+    }
+
+    ThrowingValue(int iValue) : value(iValue)
+    {
+    }
+
+    static bool throwOnConstruct;
+    int value;
+};
+
+bool ThrowingValue::throwOnConstruct = false;
+} // namespace
+
+TEST_F(FlatHashMapTest, bracketOperator_WhenValueConstructorThrows_ShouldKeepExistingEntries)
+{
+    FlatHashMap<int, ThrowingValue, TwoSlotHash> throwingMap;
+    for (int i = 0; i < 10; i++)
+    {
+        throwingMap.insert(std::pair<const int, ThrowingValue>(i, ThrowingValue(i)));
+    }
+    throwingMap.insert(std::pair<const int, ThrowingValue>(100, ThrowingValue(100)));
+
+    ThrowingValue::throwOnConstruct = true;
+    EXPECT_THROW(throwingMap[10], std::runtime_error);
+    ThrowingValue::throwOnConstruct = false;
+
+    EXPECT_EQ(throwingMap.size(), 11);
+    EXPECT_FALSE(throwingMap.contains(10));
+    EXPECT_EQ(throwingMap.at(100).value, 100);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(throwingMap.at(i).value, i);
+    }
+}
+
+TEST_F(FlatHashMapTest, replaceKey_WhenHashIsUnchanged_ShouldKeepValueAndPosition)
+{
+    FlatHashMap<int, int, TwoSlotHash> intMap;
+    for (int i = 0; i < 10; i++)
+    {
+        intMap[i] = i * 10;
+    }
+    auto it = intMap.begin();
+    ++it;
+    int oldKey = it->first;
+
+    intMap.replaceKey(it, 50);
+
+    EXPECT_EQ(it->first, 50);
+    EXPECT_EQ(it->second, oldKey * 10);
+    EXPECT_FALSE(intMap.contains(oldKey));
+    EXPECT_EQ(intMap.at(50), oldKey * 10);
+    EXPECT_EQ(intMap.size(), 10);
+}
+
+TEST_F(FlatHashMapTest, erase_WhenKeysAreStrings_ShouldMatchReference)
+{
+    std::unordered_map<std::string, std::string> reference;
+    unsigned state = 12345;
+    for (int i = 0; i < 20000; i++)
+    {
+        state = state * 1103515245u + 12345u;
+        std::string key =
+            "a key long enough to live on the heap " + std::to_string((state >> 8) % 500);
+        if (state & 1)
+        {
+            map.erase(key);
+            reference.erase(key);
+        }
+        else
+        {
+            map[key] = std::to_string(i);
+            reference[key] = std::to_string(i);
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& entry : reference)
+    {
+        EXPECT_EQ(map.at(entry.first), entry.second);
+    }
+}
+
+TEST_F(FlatHashMapTest, find_WhenElementPresent_ShouldReturnEntry)
+{
+    map["Alice"] = "Engineer";
+
+    FlatHashMap<std::string, std::string>::ValueType* entry = map.find("Alice");
+
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->second, "Engineer");
+    EXPECT_EQ(map.find("Bob"), nullptr);
+}
+
+TEST_F(FlatHashMapTest, contains_ShouldTellWhetherKeyIsPresent)
+{
+    EXPECT_FALSE(map.contains("Alice"));
+
+    map["Alice"] = "Engineer";
+
+    EXPECT_TRUE(map.contains("Alice"));
+    EXPECT_FALSE(map.contains(std::string("Bob")));
+}
+
+TEST_F(FlatHashMapTest, begin_WhenEmpty_ShouldEqualEnd)
+{
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.cbegin() == map.cend());
+}
+
+TEST_F(FlatHashMapTest, iteration_ShouldVisitEveryEntryOnce)
+{
+    FlatHashMap<int, int> numbers;
+    for (int i = 0; i < 1000; i++)
+    {
+        numbers[i] = i * 2;
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        numbers.erase(i);
+    }
+
+    std::set<int> seen;
+    for (auto& pair : numbers)
+    {
+        EXPECT_EQ(pair.second, pair.first * 2);
+        EXPECT_EQ(pair.first % 2, 1);
+        seen.insert(pair.first);
+    }
+
+    EXPECT_EQ(seen.size(), 500);
+}
+
+TEST_F(FlatHashMapTest, constIteration_ShouldVisitEveryEntry)
+{
+    map["Alice"] = "Engineer";
+    map["Bob"] = "Lawyer";
+    const FlatHashMap<std::string, std::string>& constMap = map;
+
+    size_t visited = 0;
+    for (auto it = constMap.cbegin(); it != constMap.cend(); ++it)
+    {
+        EXPECT_EQ(constMap.at(it->first), it->second);
+        ++visited;
+    }
+
+    EXPECT_EQ(visited, 2);
+}
+
+TEST_F(FlatHashMapTest, statistics_ShouldDescribeTableShape)
+{
+    FlatHashMap<int, int> numbers;
+    for (int i = 0; i < 100; i++)
+    {
+        numbers[i] = i;
+    }
+
+    ds::HashTableStats stats = numbers.statistics();
+
+    EXPECT_EQ(stats.size, 100);
+    EXPECT_GE(stats.bucketCount, 100);
+    EXPECT_FLOAT_EQ(stats.loadFactor, 100.0f / stats.bucketCount);
+    EXPECT_GT(stats.memoryBytes, 100 * sizeof(std::pair<const int, int>));
+    size_t entries = 0;
+    for (size_t distance = 0; distance < stats.probeDistances.size(); ++distance)
+    {
+        entries += stats.probeDistances[distance];
+    }
+    EXPECT_EQ(entries, 100);
+    EXPECT_TRUE(stats.chainLengths.isEmpty());
+}
+
+TEST_F(FlatHashMapTest, statistics_WhenAllKeysCollide_ShouldReportEveryProbeDistance)
+{
+    FlatHashMap<int, int, ConstantHash> intMap;
+    for (int i = 0; i < 10; i++)
+    {
+        intMap[i] = i;
+    }
+
+    ds::HashTableStats stats = intMap.statistics();
+
+    ASSERT_EQ(stats.probeDistances.size(), 10);
+    for (size_t distance = 0; distance < 10; ++distance)
+    {
+        EXPECT_EQ(stats.probeDistances[distance], 1);
+    }
+}
+
+TEST_F(FlatHashMapTest, statistics_WhenCounting_ShouldCountLookupsAndRehashes)
+{
+    FlatHashMap<int, int, ds::Hash<int>, ds::EqualTo<int>, ds::CountingStats> numbers;
+    for (int i = 0; i < 100; i++)
+    {
+        numbers[i] = i;
+    }
+    ds::HashTableStats before = numbers.statistics();
+
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_TRUE(numbers.contains(i));
+    }
+    EXPECT_FALSE(numbers.contains(1000));
+    ds::HashTableStats after = numbers.statistics();
+
+    EXPECT_GT(before.rehashes, 0);
+    EXPECT_EQ(after.lookups - before.lookups, 101);
+    EXPECT_GE(after.keyComparisons - before.keyComparisons, 100);
+    EXPECT_EQ(map.statistics().lookups, 0);
+}
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <unistd.h>
+
+#include "FrozenHashMap.h"
+
+using ds::FrozenHashMap;
+using ds::HashMap;
+
+class FrozenHashMapTest : public ::testing::Test
+{
+  protected:
+    std::string path;
+
+    void SetUp() override
+    {
+        char name[] = "/tmp/FrozenHashMapTestXXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    // Overwrites the index-th 64-bit word of the saved file's header.
+    void patchHeaderWord(long index, uint64_t value)
+    {
+        FILE* file = std::fopen(path.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        std::fseek(file, index * static_cast<long>(sizeof(uint64_t)), SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, file);
+        std::fclose(file);
+    }
+
+    uint64_t headerWord(long index)
+    {
+        uint64_t value = 0;
+        FILE* file = std::fopen(path.c_str(), "rb");
+        std::fseek(file, index * static_cast<long>(sizeof(uint64_t)), SEEK_SET);
+        EXPECT_EQ(std::fread(&value, sizeof(value), 1, file), 1u);
+        std::fclose(file);
+        return value;
+    }
+
+    // Word indices of the header fields patched by the tests.
+    enum HeaderWord : long
+    {
+        COUNT = 3,
+        BUCKET_COUNT = 4,
+        ENTRIES_OFFSET = 6
+    };
+
+    static HashMap<uint64_t, uint32_t> makeMap(uint32_t n)
+    {
+        HashMap<uint64_t, uint32_t> map;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            map[uint64_t{i} * 0x9E3779B97F4A7C15ull] = i;
+        }
+        return map;
+    }
+};
+
+TEST_F(FrozenHashMapTest, Constructor_ShouldConstructEmptyMap)
+{
+    FrozenHashMap<uint64_t, uint32_t> frozen;
+
+    EXPECT_TRUE(frozen.isEmpty());
+    EXPECT_EQ(frozen.size(), 0);
+    EXPECT_EQ(frozen.find(1), nullptr);
+    EXPECT_TRUE(frozen.begin() == frozen.end());
+}
+
+TEST_F(FrozenHashMapTest, Freeze_ShouldKeepEveryEntry)
+{
+    HashMap<uint64_t, uint32_t> map = makeMap(10000);
+
+    FrozenHashMap<uint64_t, uint32_t> frozen = ds::freeze(map);
+
+    EXPECT_EQ(frozen.size(), 10000);
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        EXPECT_EQ(frozen.at(uint64_t{i} * 0x9E3779B97F4A7C15ull), i);
+    }
+}
+
+TEST_F(FrozenHashMapTest, Find_WhenKeyIsAbsent_ShouldReturnNull)
+{
+    FrozenHashMap<uint64_t, uint32_t> frozen = ds::freeze(makeMap(1000));
+
+    for (uint64_t key = 1; key < 1000; key++)
+    {
+        EXPECT_EQ(frozen.find(key), nullptr);
+        EXPECT_FALSE(frozen.contains(key));
+    }
+    EXPECT_TRUE(frozen.contains(0));
+}
+
+TEST_F(FrozenHashMapTest, At_WhenKeyIsAbsent_ShouldThrow)
+{
+    FrozenHashMap<uint64_t, uint32_t> frozen = ds::freeze(makeMap(10));
+
+    EXPECT_THROW(frozen.at(1), std::out_of_range);
+}
+
+TEST_F(FrozenHashMapTest, Constructor_WhenGivenSmallMaps_ShouldPlaceEveryKey)
+{
+    for (uint32_t n = 1; n < 64; n++)
+    {
+        FrozenHashMap<uint64_t, uint32_t> frozen = ds::freeze(makeMap(n));
+
+        ASSERT_EQ(frozen.size(), n);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            EXPECT_EQ(frozen.at(uint64_t{i} * 0x9E3779B97F4A7C15ull), i);
+        }
+    }
+}
+
+TEST_F(FrozenHashMapTest, Constructor_WhenKeyIsDuplicated_ShouldThrow)
+{
+    std::pair<int, int> pairs[] = {{1, 1}, {2, 2}, {1, 3}};
+
+    EXPECT_THROW((FrozenHashMap<int, int>(pairs, pairs + 3)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Iteration_ShouldVisitEveryEntryOnce)
+{
+    FrozenHashMap<uint64_t, uint32_t> frozen = ds::freeze(makeMap(1000));
+
+    std::set<uint32_t> seen;
+    for (const auto& entry : frozen)
+    {
+        EXPECT_EQ(entry.first, uint64_t{entry.second} * 0x9E3779B97F4A7C15ull);
+        seen.insert(entry.second);
+    }
+
+    EXPECT_EQ(seen.size(), 1000);
+}
+
+TEST_F(FrozenHashMapTest, MoveConstructor_ShouldLeaveSourceEmpty)
+{
+    FrozenHashMap<uint64_t, uint32_t> source = ds::freeze(makeMap(100));
+
+    FrozenHashMap<uint64_t, uint32_t> target(std::move(source));
+
+    EXPECT_TRUE(source.isEmpty());
+    EXPECT_EQ(source.find(0), nullptr);
+    EXPECT_EQ(target.at(0), 0);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenFileWasSaved_ShouldFindEveryEntry)
+{
+    ds::freeze(makeMap(5000)).save(path);
+
+    FrozenHashMap<uint64_t, uint32_t> loaded = FrozenHashMap<uint64_t, uint32_t>::load(path);
+
+    EXPECT_EQ(loaded.size(), 5000);
+    for (uint32_t i = 0; i < 5000; i++)
+    {
+        EXPECT_EQ(loaded.at(uint64_t{i} * 0x9E3779B97F4A7C15ull), i);
+    }
+    EXPECT_FALSE(loaded.contains(1));
+}
+
+TEST_F(FrozenHashMapTest, Save_WhenFileIsLarger_ShouldReplaceItsContent)
+{
+    ds::freeze(makeMap(5000)).save(path);
+    ds::freeze(makeMap(10)).save(path);
+
+    FrozenHashMap<uint64_t, uint32_t> loaded = FrozenHashMap<uint64_t, uint32_t>::load(path);
+
+    EXPECT_EQ(loaded.size(), 10);
+    EXPECT_EQ(loaded.at(9 * 0x9E3779B97F4A7C15ull), 9);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenMapIsEmpty_ShouldLoadEmptyMap)
+{
+    FrozenHashMap<uint64_t, uint32_t>().save(path);
+
+    FrozenHashMap<uint64_t, uint32_t> loaded = FrozenHashMap<uint64_t, uint32_t>::load(path);
+
+    EXPECT_TRUE(loaded.isEmpty());
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenTypesDiffer_ShouldThrow)
+{
+    ds::freeze(makeMap(10)).save(path);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint64_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenFileIsNotAMap_ShouldThrow)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    uint64_t words[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::fwrite(words, sizeof(words), 1, file);
+    std::fclose(file);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenCountOverflowsEntryBytes_ShouldThrow)
+{
+    ds::freeze(makeMap(100)).save(path);
+    // Times the 16-byte entry size, this count wraps around to a small byte count.
+    patchHeaderWord(COUNT, uint64_t{1} << 60);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenCountExceedsFile_ShouldThrow)
+{
+    ds::freeze(makeMap(100)).save(path);
+    patchHeaderWord(COUNT, 101);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenPilotsOverlapEntries_ShouldThrow)
+{
+    ds::freeze(makeMap(100)).save(path);
+    patchHeaderWord(BUCKET_COUNT, headerWord(BUCKET_COUNT) + 1000);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenBucketCountIsZero_ShouldThrow)
+{
+    ds::freeze(makeMap(100)).save(path);
+    patchHeaderWord(BUCKET_COUNT, 0);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenEntriesOffsetIsMisaligned_ShouldThrow)
+{
+    ds::freeze(makeMap(100)).save(path);
+    patchHeaderWord(ENTRIES_OFFSET, headerWord(ENTRIES_OFFSET) + 4);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenEntriesOffsetIsInsideHeader_ShouldThrow)
+{
+    ds::freeze(makeMap(100)).save(path);
+    patchHeaderWord(ENTRIES_OFFSET, 8);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
+
+TEST_F(FrozenHashMapTest, Load_WhenEntriesOffsetIsPastTheEnd_ShouldThrow)
+{
+    ds::freeze(makeMap(100)).save(path);
+    patchHeaderWord(ENTRIES_OFFSET, UINT64_MAX - 15);
+
+    EXPECT_THROW((FrozenHashMap<uint64_t, uint32_t>::load(path)), std::runtime_error);
+}
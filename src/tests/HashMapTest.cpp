@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "HashMap.h"
 
+using ds::Array;
 using ds::HashMap;
 
 class HashMapTest : public ::testing::Test
@@ -154,3 +157,1049 @@ TEST_F(HashMapTest, erase_WhenElementExists_ShouldErase)
 
     EXPECT_TRUE(map.isEmpty());
 }
+
+namespace
+{
+struct ConstantHash
+{
+    size_t operator()(int) const
+    {
+        return 0;
+    }
+};
+
+struct ConstantStringHash
+{
+    using is_transparent = void;
+
+    size_t operator()(const std::string&) const
+    {
+        return 7;
+    }
+
+    size_t operator()(const char*) const
+    {
+        return 7;
+    }
+};
+
+// Not convertible to std::string: lookups with it only compile if they are heterogeneous.
+struct Name
+{
+    const char* value;
+};
+
+struct NameHash : ds::Hash<std::string>
+{
+    using ds::Hash<std::string>::operator();
+
+    size_t operator()(const Name& name) const
+    {
+        return (*this)(name.value);
+    }
+};
+
+struct NameEqual : ds::EqualTo<std::string>
+{
+    using ds::EqualTo<std::string>::operator();
+
+    bool operator()(const std::string& lhs, const Name& rhs) const
+    {
+        return lhs == rhs.value;
+    }
+};
+} // namespace
+
+TEST_F(HashMapTest, insert_WhenHasherMapsAllKeysToOneBucket_ShouldKeepAllElements)
+{
+    HashMap<int, int, ConstantHash> intMap;
+
+    for (int i = 0; i < 100; i++)
+    {
+        intMap.insert(std::pair<int, int>(i, i * 2));
+    }
+
+    EXPECT_EQ(intMap.size(), 100);
+    EXPECT_EQ(intMap.at(0), 0);
+    EXPECT_EQ(intMap.at(99), 198);
+}
+
+TEST_F(HashMapTest, at_WhenCalledWithStringLiteral_ShouldFindStringKey)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    const char* key = "Alice";
+    EXPECT_EQ(map.at(key), "Engineer");
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+    EXPECT_ANY_THROW(map.at("Bob"));
+}
+
+TEST_F(HashMapTest, at_WhenHasherIsTransparent_ShouldNotConvertKey)
+{
+    HashMap<std::string, int, NameHash, NameEqual> names;
+    names.insert(std::pair<std::string, int>("Alice", 1));
+
+    EXPECT_EQ(names.at(Name{"Alice"}), 1);
+    names.erase(Name{"Alice"});
+    EXPECT_TRUE(names.isEmpty());
+}
+
+TEST_F(HashMapTest, bracketOperator_WhenCalledWithStringLiteral_ShouldInsertOnce)
+{
+    map["Alice"] = "Engineer";
+    map["Alice"] = "Lawyer";
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.at(std::string("Alice")), "Lawyer");
+}
+
+TEST_F(HashMapTest, erase_WhenCalledWithStringLiteral_ShouldErase)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    map.erase("Alice");
+
+    EXPECT_TRUE(map.isEmpty());
+}
+
+TEST_F(HashMapTest, insert_WhenManyIntegerKeys_ShouldGrowAndKeepAllElements)
+{
+    HashMap<int, int> intMap;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        intMap.insert(std::pair<int, int>(i * 1024, i));
+    }
+
+    for (int i = 0; i < 10000; i++)
+    {
+        EXPECT_EQ(intMap.at(i * 1024), i);
+    }
+}
+
+TEST_F(HashMapTest, copyAssignmentOperator_WhenTargetIsLarger_ShouldCopyElements)
+{
+    HashMap<int, int> large;
+    for (int i = 0; i < 1000; i++)
+    {
+        large.insert(std::pair<int, int>(i, i));
+    }
+    HashMap<int, int> small;
+    small.insert(std::pair<int, int>(1, 10));
+
+    large = small;
+
+    EXPECT_EQ(large.size(), 1);
+    EXPECT_EQ(large.at(1), 10);
+    EXPECT_ANY_THROW(large.at(500));
+}
+
+namespace
+{
+struct CountingHash
+{
+    static int calls;
+
+    size_t operator()(const std::string& key) const
+    {
+        ++calls;
+        return std::hash<std::string>{}(key);
+    }
+
+    size_t operator()(int key) const
+    {
+        ++calls;
+        return static_cast<size_t>(key);
+    }
+};
+
+int CountingHash::calls = 0;
+} // namespace
+
+TEST_F(HashMapTest, resize_WhenHashIsCached_ShouldNotCallHasher)
+{
+    HashMap<std::string, int, CountingHash> strings;
+    CountingHash::calls = 0;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        strings.insert(std::pair<std::string, int>(std::to_string(i), i));
+    }
+
+    EXPECT_EQ(CountingHash::calls, 1000);
+    EXPECT_EQ(strings.at("999"), 999);
+}
+
+TEST_F(HashMapTest, resize_WhenHashIsNotCached_ShouldRehashKeys)
+{
+    EXPECT_FALSE(ds::ShouldCacheHash<int>::value);
+    HashMap<int, int, CountingHash> ints;
+    CountingHash::calls = 0;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+
+    EXPECT_GT(CountingHash::calls, 1000);
+    EXPECT_EQ(ints.at(999), 999);
+}
+
+TEST_F(HashMapTest, at_WhenHashIsCachedAndKeysCollide_ShouldFindEachKey)
+{
+    HashMap<std::string, int, ConstantStringHash> strings;
+
+    strings.insert(std::pair<std::string, int>("Alice", 1));
+    strings.insert(std::pair<std::string, int>("Bob", 2));
+    strings["Charlie"] = 3;
+
+    EXPECT_EQ(strings.at("Alice"), 1);
+    EXPECT_EQ(strings.at("Bob"), 2);
+    EXPECT_EQ(strings.at("Charlie"), 3);
+    strings.erase("Bob");
+    EXPECT_ANY_THROW(strings.at("Bob"));
+    EXPECT_EQ(strings.size(), 2);
+}
+
+TEST_F(HashMapTest, insert_WhenIncrementalRehashCrossesLoadFactor_ShouldStartMigration)
+{
+    HashMap<int, int> ints;
+    ints.setIncrementalRehash(true, 4);
+
+    for (int i = 0; i < 192; i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+
+    EXPECT_TRUE(ints.isRehashing());
+    for (int i = 0; i < 192; i++)
+    {
+        EXPECT_EQ(ints.at(i), i);
+    }
+}
+
+TEST_F(HashMapTest, insert_WhenIncrementalRehashRunsLongEnough_ShouldFinishMigration)
+{
+    HashMap<int, int> ints;
+    ints.setIncrementalRehash(true, 4);
+
+    for (int i = 0; i < 192; i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+    for (int i = 192; i < 300 && ints.isRehashing(); i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+
+    EXPECT_FALSE(ints.isRehashing());
+    EXPECT_EQ(ints.at(0), 0);
+    EXPECT_EQ(ints.at(191), 191);
+}
+
+TEST_F(HashMapTest, operations_WhenIncrementalRehashInProgress_ShouldSeeBothTables)
+{
+    map.setIncrementalRehash(true, 1);
+    for (int i = 0; i < 1000; i++)
+    {
+        map[std::to_string(i)] = std::to_string(i);
+    }
+    ASSERT_TRUE(map.isRehashing());
+
+    EXPECT_THROW(map.insert(std::pair<std::string, std::string>("0", "x")), std::runtime_error);
+    map["1"] = "one";
+    map.erase("2");
+
+    EXPECT_EQ(map.size(), 999);
+    EXPECT_EQ(map.at("0"), "0");
+    EXPECT_EQ(map.at("1"), "one");
+    EXPECT_THROW(map.at("2"), std::out_of_range);
+    EXPECT_EQ(map.at("999"), "999");
+}
+
+TEST_F(HashMapTest, copyConstructor_WhenIncrementalRehashInProgress_ShouldCopyBothTables)
+{
+    HashMap<int, int> ints;
+    ints.setIncrementalRehash(true, 1);
+    for (int i = 0; i < 1000; i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+    ASSERT_TRUE(ints.isRehashing());
+
+    HashMap<int, int> copy(ints);
+    HashMap<int, int> moved(std::move(ints));
+
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(copy.at(i), i);
+        EXPECT_EQ(moved.at(i), i);
+    }
+    EXPECT_TRUE(ints.isEmpty());
+    EXPECT_FALSE(ints.isRehashing());
+}
+
+TEST_F(HashMapTest, setIncrementalRehash_WhenDisabledDuringMigration_ShouldFinishIt)
+{
+    HashMap<int, int> ints;
+    ints.setIncrementalRehash(true, 1);
+    for (int i = 0; i < 1000; i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+    ASSERT_TRUE(ints.isRehashing());
+
+    ints.setIncrementalRehash(false);
+
+    EXPECT_FALSE(ints.isRehashing());
+    EXPECT_EQ(ints.size(), 1000);
+    EXPECT_EQ(ints.at(500), 500);
+}
+
+TEST_F(HashMapTest, clear_WhenIncrementalRehashInProgress_ShouldDropBothTables)
+{
+    HashMap<int, int> ints;
+    ints.setIncrementalRehash(true, 1);
+    for (int i = 0; i < 1000; i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+
+    ints.clear();
+
+    EXPECT_TRUE(ints.isEmpty());
+    EXPECT_FALSE(ints.isRehashing());
+    EXPECT_ANY_THROW(ints.at(1));
+}
+
+TEST_F(HashMapTest, clear_WhenIncrementalRehashInProgress_ShouldLeaveUsableMap)
+{
+    HashMap<int, int> ints;
+    ints.setIncrementalRehash(true, 1);
+    for (int i = 0; !ints.isRehashing(); i++)
+    {
+        ints.insert(std::pair<int, int>(i, i));
+    }
+
+    ints.clear();
+    for (int i = 0; i < 1000; i++)
+    {
+        ints.insert(std::pair<int, int>(i, -i));
+    }
+
+    EXPECT_EQ(ints.size(), 1000);
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(ints.at(i), -i);
+    }
+}
+
+TEST_F(HashMapTest, iteration_WhenIncrementalRehashJustStarted_ShouldVisitEveryEntryOnce)
+{
+    HashMap<int, int> ints;
+    ints.setIncrementalRehash(true, 1);
+    int inserted = 0;
+    while (!ints.isRehashing())
+    {
+        ints.insert(std::pair<int, int>(inserted, inserted));
+        inserted++;
+    }
+
+    std::set<int> visited;
+    for (const auto& pair : ints)
+    {
+        EXPECT_TRUE(visited.insert(pair.first).second);
+    }
+
+    EXPECT_EQ(visited.size(), static_cast<size_t>(inserted));
+    EXPECT_EQ(*visited.rbegin(), inserted - 1);
+}
+
+namespace
+{
+struct Counted
+{
+    static int copies;
+    static int moves;
+
+    explicit Counted(int iValue = 0) : value(iValue)
+    {
+    }
+
+    Counted(const Counted& other) : value(other.value)
+    {
+        ++copies;
+    }
+
+    Counted(Counted&& other) noexcept : value(other.value)
+    {
+        ++moves;
+    }
+
+    Counted& operator=(const Counted& other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+
+    Counted& operator=(Counted&& other) noexcept
+    {
+        value = other.value;
+        ++moves;
+        return *this;
+    }
+
+    int value;
+};
+
+int Counted::copies = 0;
+int Counted::moves = 0;
+} // namespace
+
+TEST_F(HashMapTest, emplace_WhenKeyIsNew_ShouldConstructPairInPlace)
+{
+    HashMap<int, Counted> counted;
+    Counted::copies = 0;
+    Counted::moves = 0;
+
+    auto result = counted.emplace(std::piecewise_construct, std::forward_as_tuple(1),
+                                  std::forward_as_tuple(10));
+
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(result.first.second.value, 10);
+    EXPECT_EQ(Counted::copies, 0);
+    EXPECT_EQ(Counted::moves, 0);
+}
+
+TEST_F(HashMapTest, emplace_WhenKeyExists_ShouldReturnExistingEntry)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    auto result = map.emplace("Alice", "Lawyer");
+
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first.second, "Engineer");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(HashMapTest, tryEmplace_WhenKeyExists_ShouldNotTouchArguments)
+{
+    HashMap<int, Counted> counted;
+    counted.tryEmplace(1, 10);
+    Counted value(20);
+    Counted::copies = 0;
+    Counted::moves = 0;
+
+    auto result = counted.tryEmplace(1, std::move(value));
+
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first.second.value, 10);
+    EXPECT_EQ(Counted::moves, 0);
+}
+
+TEST_F(HashMapTest, tryEmplace_WhenKeyIsNew_ShouldMoveKeyAndValue)
+{
+    std::string key(100, 'k');
+    std::string value(100, 'v');
+
+    auto result = map.tryEmplace(std::move(key), std::move(value));
+
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(result.first.first, std::string(100, 'k'));
+    EXPECT_EQ(map.at(std::string(100, 'k')), std::string(100, 'v'));
+}
+
+TEST_F(HashMapTest, hashedVariants_WhenGivenTheKeyHash_ShouldBehaveLikeUnhashedOnes)
+{
+    size_t hash = ds::Hash<std::string>()("Alice");
+
+    EXPECT_TRUE(map.tryEmplaceHashed(hash, "Alice", "Engineer").second);
+    EXPECT_FALSE(map.insertOrAssignHashed(hash, "Alice", "Lawyer").second);
+    ASSERT_NE(map.findHashed(hash, "Alice"), nullptr);
+    EXPECT_EQ(map.at("Alice"), "Lawyer");
+    EXPECT_TRUE(map.eraseHashed(hash, "Alice"));
+    EXPECT_FALSE(map.eraseHashed(hash, "Alice"));
+    EXPECT_EQ(map.findHashed(hash, "Alice"), nullptr);
+}
+
+TEST_F(HashMapTest, insertOrAssign_WhenCalled_ShouldInsertThenAssign)
+{
+    auto inserted = map.insertOrAssign("Alice", "Engineer");
+    auto assigned = map.insertOrAssign("Alice", "Lawyer");
+
+    EXPECT_TRUE(inserted.second);
+    EXPECT_FALSE(assigned.second);
+    EXPECT_EQ(map.at("Alice"), "Lawyer");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(HashMapTest, resize_WhenGrowing_ShouldNotCopyOrMoveEntries)
+{
+    HashMap<int, Counted> counted;
+    for (int i = 0; i < 100; i++)
+    {
+        counted.tryEmplace(i, i);
+    }
+    Counted* address = &counted.at(42);
+    Counted::copies = 0;
+    Counted::moves = 0;
+
+    counted.resize(4096);
+
+    EXPECT_EQ(Counted::copies, 0);
+    EXPECT_EQ(Counted::moves, 0);
+    EXPECT_EQ(&counted.at(42), address);
+}
+
+TEST_F(HashMapTest, bracketOperator_WhenKeyIsRvalue_ShouldMoveIt)
+{
+    std::string key(100, 'k');
+
+    map[std::move(key)] = "value";
+
+    EXPECT_EQ(map.at(std::string(100, 'k')), "value");
+}
+
+TEST_F(HashMapTest, find_WhenElementPresent_ShouldReturnEntry)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    HashMap<std::string, std::string>::ValueType* entry = map.find("Alice");
+
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->first, "Alice");
+    EXPECT_EQ(entry->second, "Engineer");
+}
+
+TEST_F(HashMapTest, find_WhenElementNotPresent_ShouldReturnNull)
+{
+    map.insert(std::pair<std::string, std::string>("Alice", "Engineer"));
+
+    EXPECT_EQ(map.find("Bob"), nullptr);
+}
+
+TEST_F(HashMapTest, contains_ShouldTellWhetherKeyIsPresent)
+{
+    map["Alice"] = "Engineer";
+
+    EXPECT_TRUE(map.contains("Alice"));
+    EXPECT_TRUE(map.contains(std::string("Alice")));
+    EXPECT_FALSE(map.contains("Bob"));
+}
+
+TEST_F(HashMapTest, begin_WhenEmpty_ShouldEqualEnd)
+{
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.cbegin() == map.cend());
+}
+
+TEST_F(HashMapTest, iteration_ShouldVisitEveryEntryOnce)
+{
+    HashMap<int, int> numbers;
+    for (int i = 0; i < 1000; i++)
+    {
+        numbers[i] = i * 2;
+    }
+
+    std::set<int> seen;
+    for (auto& pair : numbers)
+    {
+        EXPECT_EQ(pair.second, pair.first * 2);
+        seen.insert(pair.first);
+    }
+
+    EXPECT_EQ(seen.size(), 1000);
+}
+
+TEST_F(HashMapTest, iteration_WhenRehashing_ShouldVisitBothTables)
+{
+    HashMap<int, int> numbers;
+    numbers.setIncrementalRehash(true, 1);
+    int inserted = 0;
+    while (!numbers.isRehashing())
+    {
+        numbers[inserted] = inserted;
+        ++inserted;
+    }
+
+    std::set<int> seen;
+    for (auto it = numbers.begin(); it != numbers.end(); ++it)
+    {
+        seen.insert(it->first);
+    }
+
+    EXPECT_EQ(seen.size(), inserted);
+}
+
+TEST_F(HashMapTest, iteration_ShouldAllowModifyingValues)
+{
+    map["Alice"] = "Engineer";
+    map["Bob"] = "Lawyer";
+
+    for (auto& pair : map)
+    {
+        pair.second += "!";
+    }
+
+    EXPECT_EQ(map.at("Alice"), "Engineer!");
+    EXPECT_EQ(map.at("Bob"), "Lawyer!");
+}
+
+TEST_F(HashMapTest, constIteration_ShouldVisitEveryEntry)
+{
+    map["Alice"] = "Engineer";
+    map["Bob"] = "Lawyer";
+    const HashMap<std::string, std::string>& constMap = map;
+
+    size_t visited = 0;
+    for (const auto& pair : constMap)
+    {
+        EXPECT_EQ(constMap.at(pair.first), pair.second);
+        ++visited;
+    }
+
+    EXPECT_EQ(visited, 2);
+}
+
+TEST_F(HashMapTest, findMany_ShouldResolveHitsAndMisses)
+{
+    HashMap<int, int> numbers;
+    for (int i = 0; i < 1000; i += 2)
+    {
+        numbers[i] = i * 2;
+    }
+    int keys[100];
+    HashMap<int, int>::ValueType* results[100];
+    for (int i = 0; i < 100; i++)
+    {
+        keys[i] = i * 7;
+    }
+
+    numbers.findMany(keys, 100, results);
+
+    for (int i = 0; i < 100; i++)
+    {
+        if (keys[i] % 2 == 0)
+        {
+            ASSERT_NE(results[i], nullptr);
+            EXPECT_EQ(results[i]->second, keys[i] * 2);
+        }
+        else
+        {
+            EXPECT_EQ(results[i], nullptr);
+        }
+    }
+}
+
+TEST_F(HashMapTest, findMany_WhenRehashing_ShouldFindEntriesOfBothTables)
+{
+    HashMap<int, int> numbers;
+    numbers.setIncrementalRehash(true, 1);
+    int inserted = 0;
+    while (!numbers.isRehashing())
+    {
+        numbers[inserted] = inserted;
+        ++inserted;
+    }
+    Array<int> keys;
+    Array<HashMap<int, int>::ValueType*> results;
+    for (int i = 0; i < inserted; i++)
+    {
+        keys.pushBack(i);
+    }
+    results.resize(keys.size());
+
+    numbers.findMany(&keys[0], keys.size(), &results[0]);
+
+    for (int i = 0; i < inserted; i++)
+    {
+        ASSERT_NE(results[i], nullptr);
+        EXPECT_EQ(results[i]->second, i);
+    }
+}
+
+TEST_F(HashMapTest, findMany_WhenGivenHeterogeneousKeys_ShouldFindEntries)
+{
+    map["Alice"] = "Engineer";
+    const char* keys[] = {"Bob", "Alice"};
+    HashMap<std::string, std::string>::ValueType* results[2];
+
+    map.findMany(keys, 2, results);
+
+    EXPECT_EQ(results[0], nullptr);
+    ASSERT_NE(results[1], nullptr);
+    EXPECT_EQ(results[1]->second, "Engineer");
+}
+
+namespace
+{
+template <typename Map, typename K, typename = void>
+struct CanFindMany : std::false_type
+{
+};
+
+template <typename Map, typename K>
+struct CanFindMany<Map, K,
+                   decltype(std::declval<const Map&>().findMany(
+                                std::declval<const K*>(), size_t{},
+                                std::declval<typename Map::ValueType**>()),
+                            void())> : std::true_type
+{
+};
+} // namespace
+
+TEST_F(HashMapTest, findMany_WhenHasherIsNotTransparent_ShouldOnlyAcceptKeys)
+{
+    using Plain = HashMap<std::string, int, std::hash<std::string>, std::equal_to<std::string>>;
+
+    EXPECT_FALSE((CanFindMany<Plain, const char*>::value));
+    EXPECT_TRUE((CanFindMany<Plain, std::string>::value));
+    EXPECT_TRUE((CanFindMany<HashMap<std::string, int>, const char*>::value));
+}
+
+TEST_F(HashMapTest, reserve_ShouldLetExpectedEntriesFitWithoutGrowing)
+{
+    HashMap<int, int> numbers;
+
+    numbers.reserve(10000);
+    size_t buckets = numbers.bucketCount();
+    for (int i = 0; i < 10000; i++)
+    {
+        numbers[i] = i;
+    }
+
+    EXPECT_EQ(numbers.bucketCount(), buckets);
+    EXPECT_LT(numbers.loadFactor(), numbers.maxLoadFactor());
+}
+
+TEST_F(HashMapTest, reserve_WhenSmallerThanTable_ShouldNotShrink)
+{
+    size_t buckets = map.bucketCount();
+
+    map.reserve(1);
+
+    EXPECT_EQ(map.bucketCount(), buckets);
+}
+
+TEST_F(HashMapTest, rehash_WhenGivenLargerCount_ShouldGrowToPowerOfTwo)
+{
+    map["Alice"] = "Engineer";
+
+    map.rehash(1000);
+
+    EXPECT_EQ(map.bucketCount(), 1024);
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+}
+
+TEST_F(HashMapTest, rehash_WhenGivenTooSmallCount_ShouldKeepLoadBelowMax)
+{
+    HashMap<int, int> numbers;
+    for (int i = 0; i < 1000; i++)
+    {
+        numbers[i] = i;
+    }
+
+    numbers.rehash(1);
+
+    EXPECT_LT(numbers.loadFactor(), numbers.maxLoadFactor());
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(numbers.at(i), i);
+    }
+}
+
+TEST_F(HashMapTest, shrinkToFit_WhenMostEntriesErased_ShouldShrinkTable)
+{
+    HashMap<int, int> numbers;
+    for (int i = 0; i < 10000; i++)
+    {
+        numbers[i] = i;
+    }
+    for (int i = 10; i < 10000; i++)
+    {
+        numbers.erase(i);
+    }
+
+    numbers.shrinkToFit();
+
+    EXPECT_LE(numbers.bucketCount(), 16);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(numbers.at(i), i);
+    }
+}
+
+TEST_F(HashMapTest, shrinkToFit_WhenRehashing_ShouldFinishMigration)
+{
+    HashMap<int, int> numbers;
+    numbers.setIncrementalRehash(true, 1);
+    int inserted = 0;
+    while (!numbers.isRehashing())
+    {
+        numbers[inserted] = inserted;
+        ++inserted;
+    }
+
+    numbers.shrinkToFit();
+
+    EXPECT_FALSE(numbers.isRehashing());
+    EXPECT_EQ(numbers.size(), inserted);
+    for (int i = 0; i < inserted; i++)
+    {
+        EXPECT_EQ(numbers.at(i), i);
+    }
+}
+
+TEST_F(HashMapTest, setMaxLoadFactor_WhenLowered_ShouldRehashToFit)
+{
+    HashMap<int, int> numbers;
+    for (int i = 0; i < 150; i++)
+    {
+        numbers[i] = i;
+    }
+
+    numbers.setMaxLoadFactor(0.25f);
+
+    EXPECT_LT(numbers.loadFactor(), 0.25f);
+    EXPECT_EQ(numbers.at(149), 149);
+}
+
+TEST_F(HashMapTest, setMaxLoadFactor_WhenRaised_ShouldDelayGrowth)
+{
+    HashMap<int, int> numbers;
+    numbers.setMaxLoadFactor(4.0f);
+    size_t buckets = numbers.bucketCount();
+
+    for (int i = 0; i < static_cast<int>(buckets) * 3; i++)
+    {
+        numbers[i] = i;
+    }
+
+    EXPECT_EQ(numbers.bucketCount(), buckets);
+}
+
+TEST_F(HashMapTest, setMaxLoadFactor_WhenNotPositive_ShouldThrow)
+{
+    EXPECT_THROW(map.setMaxLoadFactor(0.0f), std::runtime_error);
+    EXPECT_THROW(map.setMaxLoadFactor(-1.0f), std::runtime_error);
+}
+
+TEST_F(HashMapTest, setMaxLoadFactor_WhenTiny_ShouldThrowAndKeepPreviousFactor)
+{
+    map["Alice"] = "Engineer";
+
+    EXPECT_THROW(map.setMaxLoadFactor(1e-30f), std::runtime_error);
+    EXPECT_EQ(map.maxLoadFactor(), 0.75f);
+    EXPECT_EQ(map.at("Alice"), "Engineer");
+}
+
+TEST_F(HashMapTest, reserve_WhenBucketCountWouldOverflow_ShouldThrowLengthError)
+{
+    map.setMaxLoadFactor(0.01f);
+
+    EXPECT_THROW(map.reserve(SIZE_MAX / 2), std::length_error);
+    EXPECT_THROW(map.rehash(SIZE_MAX), std::length_error);
+}
+
+TEST_F(HashMapTest, moveAssignmentOperator_WhenRehashing_ShouldLeaveSourceUsable)
+{
+    HashMap<int, int> numbers;
+    numbers.setIncrementalRehash(true, 1);
+    int inserted = 0;
+    while (!numbers.isRehashing())
+    {
+        numbers[inserted] = inserted;
+        ++inserted;
+    }
+    HashMap<int, int> target;
+
+    target = std::move(numbers);
+    numbers[1] = 1;
+
+    EXPECT_EQ(target.size(), inserted);
+    EXPECT_EQ(target.at(inserted - 1), inserted - 1);
+    EXPECT_EQ(numbers.size(), 1);
+}
+
+TEST_F(HashMapTest, statistics_ShouldDescribeTableShape)
+{
+    HashMap<int, int> numbers;
+    for (int i = 0; i < 100; i++)
+    {
+        numbers[i] = i;
+    }
+
+    ds::HashTableStats stats = numbers.statistics();
+
+    EXPECT_EQ(stats.size, 100);
+    EXPECT_EQ(stats.bucketCount, numbers.bucketCount());
+    EXPECT_FLOAT_EQ(stats.loadFactor, numbers.loadFactor());
+    EXPECT_GT(stats.memoryBytes, 100 * sizeof(std::pair<const int, int>));
+    size_t buckets = 0;
+    size_t entries = 0;
+    for (size_t length = 0; length < stats.chainLengths.size(); ++length)
+    {
+        buckets += stats.chainLengths[length];
+        entries += length * stats.chainLengths[length];
+    }
+    EXPECT_EQ(buckets, stats.bucketCount);
+    EXPECT_EQ(entries, 100);
+}
+
+TEST_F(HashMapTest, statistics_WhenAllKeysCollide_ShouldReportOneLongChain)
+{
+    HashMap<int, int, ConstantHash> intMap;
+    for (int i = 0; i < 10; i++)
+    {
+        intMap[i] = i;
+    }
+
+    ds::HashTableStats stats = intMap.statistics();
+
+    ASSERT_EQ(stats.chainLengths.size(), 11);
+    EXPECT_EQ(stats.chainLengths[10], 1);
+    EXPECT_EQ(stats.chainLengths[0], stats.bucketCount - 1);
+}
+
+TEST_F(HashMapTest, statistics_WhenKeysOnlyDifferAboveBit32_ShouldKeepChainsShort)
+{
+    HashMap<uint64_t, int> highBitMap;
+    highBitMap.reserve(100000);
+    for (uint64_t i = 0; i < 100000; i++)
+    {
+        highBitMap[i << 40] = 1;
+    }
+
+    ds::HashTableStats stats = highBitMap.statistics();
+
+    EXPECT_LT(stats.chainLengths.size(), 10u);
+    EXPECT_GT(stats.bucketCount - stats.chainLengths[0], stats.bucketCount / 4);
+}
+
+TEST_F(HashMapTest, statistics_WhenNotCounting_ShouldLeaveCountersAtZero)
+{
+    map["Alice"] = "Engineer";
+    map.find("Alice");
+
+    ds::HashTableStats stats = map.statistics();
+
+    EXPECT_EQ(stats.lookups, 0);
+    EXPECT_EQ(stats.keyComparisons, 0);
+    EXPECT_EQ(stats.rehashes, 0);
+}
+
+TEST_F(HashMapTest, statistics_WhenCounting_ShouldCountLookupsComparisonsAndRehashes)
+{
+    HashMap<int, int, ds::Hash<int>, ds::EqualTo<int>, ds::CountingStats> numbers;
+    for (int i = 0; i < 1000; i++)
+    {
+        numbers[i] = i;
+    }
+    ds::HashTableStats before = numbers.statistics();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_TRUE(numbers.contains(i));
+    }
+    ds::HashTableStats after = numbers.statistics();
+
+    EXPECT_GT(before.rehashes, 0);
+    EXPECT_GE(before.rehashMilliseconds, 0);
+    EXPECT_EQ(after.lookups - before.lookups, 1000);
+    EXPECT_GE(after.keyComparisons - before.keyComparisons, 1000);
+    EXPECT_EQ(after.rehashes, before.rehashes);
+}
+
+TEST_F(HashMapTest, statistics_WhenAllKeysCollide_ShouldReportManyComparisonsPerLookup)
+{
+    HashMap<int, int, ConstantHash, ds::EqualTo<int>, ds::CountingStats> intMap;
+    for (int i = 0; i < 50; i++)
+    {
+        intMap[i] = i;
+    }
+
+    EXPECT_GT(intMap.statistics().comparisonsPerLookup(), 10.0);
+}
+
+TEST_F(HashMapTest, buildFrom_ShouldContainEveryPair)
+{
+    Array<std::pair<int, int>> pairs;
+    for (int i = 0; i < 200000; i++)
+    {
+        pairs.pushBack(std::pair<int, int>(i * 7, i));
+    }
+    ds::ThreadPool pool(4);
+
+    HashMap<int, int> numbers = HashMap<int, int>::buildFrom(pool, pairs);
+
+    EXPECT_EQ(numbers.size(), 200000);
+    for (int i = 0; i < 200000; i++)
+    {
+        ASSERT_EQ(numbers.at(i * 7), i);
+    }
+    EXPECT_FALSE(numbers.contains(1));
+    EXPECT_LT(numbers.loadFactor(), numbers.maxLoadFactor());
+}
+
+TEST_F(HashMapTest, buildFrom_ShouldSizeTableLikeReserve)
+{
+    Array<std::pair<int, int>> pairs;
+    for (int i = 0; i < 5000; i++)
+    {
+        pairs.pushBack(std::pair<int, int>(i, i));
+    }
+    HashMap<int, int> reserved;
+    reserved.reserve(pairs.size());
+    ds::ThreadPool pool(2);
+
+    HashMap<int, int> numbers = HashMap<int, int>::buildFrom(pool, pairs);
+
+    EXPECT_EQ(numbers.bucketCount(), reserved.bucketCount());
+}
+
+TEST_F(HashMapTest, buildFrom_WhenKeysRepeat_ShouldKeepLastValue)
+{
+    Array<std::pair<std::string, std::string>> pairs;
+    pairs.pushBack(std::pair<std::string, std::string>("Alice", "Engineer"));
+    pairs.pushBack(std::pair<std::string, std::string>("Bob", "Lawyer"));
+    pairs.pushBack(std::pair<std::string, std::string>("Alice", "Manager"));
+    ds::ThreadPool pool(2);
+
+    map = HashMap<std::string, std::string>::buildFrom(pool, pairs);
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at("Alice"), "Manager");
+    EXPECT_EQ(map.at("Bob"), "Lawyer");
+}
+
+TEST_F(HashMapTest, buildFrom_WhenAllKeysCollide_ShouldChainThemInOneBucket)
+{
+    Array<std::pair<const int, int>> pairs;
+    for (int i = 0; i < 100; i++)
+    {
+        pairs.emplaceBack(i, i);
+    }
+    ds::ThreadPool pool(2);
+
+    HashMap<int, int, ConstantHash> intMap =
+        HashMap<int, int, ConstantHash>::buildFrom(pool, pairs);
+
+    EXPECT_EQ(intMap.size(), 100);
+    EXPECT_EQ(intMap.at(99), 99);
+    intMap[100] = 100;
+    EXPECT_EQ(intMap.size(), 101);
+}
+
+TEST_F(HashMapTest, buildFrom_WhenEmpty_ShouldBuildEmptyMap)
+{
+    ds::ThreadPool pool(2);
+
+    Array<std::pair<std::string, std::string>> pairs;
+
+    map = HashMap<std::string, std::string>::buildFrom(pool, pairs);
+
+    EXPECT_TRUE(map.isEmpty());
+    map["Alice"] = "Engineer";
+    EXPECT_EQ(map.size(), 1);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Hash.h"
+
+using ds::EqualTo;
+using ds::Hash;
+
+TEST(HashTest, Hash_WhenStringAndLiteralHaveSameContent_ShouldMatch)
+{
+    Hash<std::string> hash;
+
+    EXPECT_EQ(hash(std::string("Alice")), hash("Alice"));
+    EXPECT_NE(hash(std::string("Alice")), hash("Alicf"));
+}
+TEST(HashTest, Hash_WhenStringsDifferAfterEightBytes_ShouldDiffer)
+{
+    Hash<std::string> hash;
+
+    EXPECT_NE(hash("abcdefgh1"), hash("abcdefgh2"));
+    EXPECT_NE(hash("abcdefgh"), hash(std::string("abcdefgh\0", 9)));
+}
+TEST(HashTest, EqualTo_WhenComparingStringWithLiteral_ShouldCompareContent)
+{
+    EqualTo<std::string> equal;
+
+    EXPECT_TRUE(equal(std::string("Alice"), "Alice"));
+    EXPECT_FALSE(equal(std::string("Alice"), "Ali"));
+}
+TEST(HashTest, IsTransparent_ShouldDetectStringHasher)
+{
+    EXPECT_TRUE(ds::IsTransparent<Hash<std::string>>::value);
+    EXPECT_FALSE(ds::IsTransparent<Hash<int>>::value);
+}
+TEST(HashTest, MixHash_WhenInputsAreMultiplesOfPowerOfTwo_ShouldSpreadLowBits)
+{
+    bool seen[64] = {};
+    for (size_t i = 0; i < 64; i++)
+    {
+        seen[ds::mixHash(i * 1024) & 63] = true;
+    }
+
+    int distinct = 0;
+    for (bool bucket : seen)
+    {
+        distinct += bucket ? 1 : 0;
+    }
+    EXPECT_GT(distinct, 32);
+}
+TEST(HashTest, MixHash_WhenInputsOnlyDifferAboveBit32_ShouldSpreadLowBits)
+{
+    bool seen[64] = {};
+    for (size_t i = 0; i < 64; i++)
+    {
+        seen[ds::mixHash(i << 40) & 63] = true;
+    }
+
+    int distinct = 0;
+    for (bool bucket : seen)
+    {
+        distinct += bucket ? 1 : 0;
+    }
+    EXPECT_GT(distinct, 32);
+}
@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "LruCache.h"
+
+using ds::LruCache;
+
+class LruCacheTest : public ::testing::Test
+{
+  protected:
+    LruCache<int, std::string> cache{3};
+};
+
+namespace
+{
+struct StringBytes
+{
+    size_t operator()(const std::string& key, const std::string& value) const
+    {
+        return key.size() + value.size();
+    }
+};
+
+// Counts the instances alive, to check how many copies of each key a cache keeps.
+struct CountedKey
+{
+    CountedKey(int iId) : id(iId)
+    {
+        alive++;
+    }
+
+    CountedKey(const CountedKey& other) : id(other.id)
+    {
+        alive++;
+    }
+
+    CountedKey& operator=(const CountedKey&) = default;
+
+    ~CountedKey()
+    {
+        alive--;
+    }
+
+    bool operator==(const CountedKey& other) const
+    {
+        return id == other.id;
+    }
+
+    static int alive;
+    int id;
+};
+
+int CountedKey::alive = 0;
+
+struct CountedKeyHash
+{
+    size_t operator()(const CountedKey& key) const
+    {
+        return static_cast<size_t>(key.id);
+    }
+};
+
+struct CountingHash
+{
+    size_t operator()(int key) const
+    {
+        calls++;
+        return static_cast<size_t>(key);
+    }
+
+    static int calls;
+};
+
+int CountingHash::calls = 0;
+} // namespace
+
+TEST_F(LruCacheTest, Constructor_WhenCapacityIsZero_ShouldThrow)
+{
+    EXPECT_THROW((LruCache<int, int>(0)), std::runtime_error);
+}
+TEST_F(LruCacheTest, Constructor_ShouldConstructEmptyCache)
+{
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_EQ(cache.capacity(), 3u);
+    EXPECT_EQ(cache.get(1), nullptr);
+}
+TEST_F(LruCacheTest, Put_WhenKeyIsNew_ShouldStoreValue)
+{
+    EXPECT_TRUE(cache.put(1, "one"));
+
+    ASSERT_NE(cache.get(1), nullptr);
+    EXPECT_EQ(*cache.get(1), "one");
+    EXPECT_EQ(cache.size(), 1u);
+}
+TEST_F(LruCacheTest, Put_WhenKeyExists_ShouldReplaceValue)
+{
+    cache.put(1, "one");
+    cache.put(1, "uno");
+
+    EXPECT_EQ(*cache.get(1), "uno");
+    EXPECT_EQ(cache.size(), 1u);
+}
+TEST_F(LruCacheTest, Put_WhenFull_ShouldEvictLeastRecentlyUsed)
+{
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    cache.put(4, "four");
+
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(4));
+}
+TEST_F(LruCacheTest, Get_WhenKeyIsCached_ShouldMarkItMostRecentlyUsed)
+{
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    cache.get(1);
+    cache.put(4, "four");
+
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(cache.leastRecentKey(), 3);
+}
+TEST_F(LruCacheTest, Peek_WhenKeyIsCached_ShouldNotChangeEvictionOrder)
+{
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    EXPECT_EQ(*cache.peek(1), "one");
+    cache.put(4, "four");
+
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.peek(1), nullptr);
+}
+TEST_F(LruCacheTest, Erase_WhenCalled_ShouldReportWhetherKeyWasCached)
+{
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.erase(1));
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(*cache.get(2), "two");
+    EXPECT_EQ(*cache.get(3), "three");
+    EXPECT_EQ(cache.leastRecentKey(), 2);
+}
+TEST_F(LruCacheTest, Clear_WhenCalled_ShouldEmptyCache)
+{
+    cache.put(1, "one");
+    cache.put(2, "two");
+
+    cache.clear();
+
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_EQ(cache.totalCost(), 0u);
+    EXPECT_THROW(cache.leastRecentKey(), std::runtime_error);
+    cache.put(3, "three");
+    EXPECT_EQ(*cache.get(3), "three");
+}
+TEST_F(LruCacheTest, SetCapacity_WhenLowered_ShouldEvictOldestEntries)
+{
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    cache.setCapacity(1);
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_THROW(cache.setCapacity(0), std::runtime_error);
+}
+TEST_F(LruCacheTest, Put_WhenBoundedByBytes_ShouldEvictUntilCostFits)
+{
+    LruCache<std::string, std::string, ds::Hash<std::string>, ds::EqualTo<std::string>,
+             StringBytes>
+        bytes(10);
+    bytes.put("a", "1234");
+    bytes.put("b", "1234");
+
+    bytes.put("c", "12345678");
+
+    EXPECT_EQ(bytes.size(), 1u);
+    EXPECT_EQ(bytes.totalCost(), 9u);
+    EXPECT_TRUE(bytes.contains("c"));
+}
+TEST_F(LruCacheTest, Put_WhenValueGrowsPastCapacity_ShouldEvictOthersButKeepIt)
+{
+    LruCache<std::string, std::string, ds::Hash<std::string>, ds::EqualTo<std::string>,
+             StringBytes>
+        bytes(10);
+    bytes.put("a", "12");
+    bytes.put("b", "12");
+
+    bytes.put("a", "12345678");
+
+    EXPECT_FALSE(bytes.contains("b"));
+    EXPECT_EQ(*bytes.get("a"), "12345678");
+    EXPECT_EQ(bytes.totalCost(), 9u);
+}
+TEST_F(LruCacheTest, Put_WhenEntryCostsMoreThanCapacity_ShouldNotCacheIt)
+{
+    LruCache<std::string, std::string, ds::Hash<std::string>, ds::EqualTo<std::string>,
+             StringBytes>
+        bytes(10);
+    bytes.put("a", "12");
+    bytes.put("b", "12");
+
+    EXPECT_FALSE(bytes.put("a", "1234567890"));
+
+    EXPECT_FALSE(bytes.contains("a"));
+    EXPECT_TRUE(bytes.contains("b"));
+    EXPECT_EQ(bytes.totalCost(), 3u);
+}
+TEST_F(LruCacheTest, Put_WhenEvictingAndErasing_ShouldStoreEachKeyOnce)
+{
+    LruCache<CountedKey, int, CountedKeyHash> counted(100);
+    for (int i = 0; i < 300; i++)
+    {
+        counted.put(CountedKey(i), i);
+    }
+    for (int i = 200; i < 250; i++)
+    {
+        counted.erase(CountedKey(i));
+    }
+
+    EXPECT_EQ(CountedKey::alive, 50);
+    EXPECT_EQ(*counted.get(CountedKey(299)), 299);
+    EXPECT_FALSE(counted.contains(CountedKey(199)));
+}
+TEST_F(LruCacheTest, Put_WhenEvicting_ShouldHashEachKeyOnce)
+{
+    LruCache<int, int, CountingHash> counted(20);
+    for (int i = 0; i < 100; i++)
+    {
+        counted.put(i, i);
+    }
+    counted.setCapacity(5);
+    counted.erase(99);
+
+    EXPECT_EQ(CountingHash::calls, 101);
+    EXPECT_EQ(counted.size(), 4u);
+}
+TEST_F(LruCacheTest, Operations_WhenRandomized_ShouldMatchReferenceLru)
+{
+    LruCache<int, int> lru(64);
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> positions;
+    std::mt19937 random(7);
+
+    for (int step = 0; step < 100000; step++)
+    {
+        int key = static_cast<int>(random() % 128);
+        auto position = positions.find(key);
+        switch (random() % 3)
+        {
+        case 0:
+            lru.put(key, step);
+            if (position != positions.end())
+            {
+                order.erase(position->second);
+            }
+            order.emplace_front(key, step);
+            positions[key] = order.begin();
+            if (order.size() > 64)
+            {
+                positions.erase(order.back().first);
+                order.pop_back();
+            }
+            break;
+        case 1:
+            if (position == positions.end())
+            {
+                ASSERT_EQ(lru.get(key), nullptr);
+            }
+            else
+            {
+                ASSERT_NE(lru.get(key), nullptr);
+                ASSERT_EQ(*lru.get(key), position->second->second);
+                order.splice(order.begin(), order, position->second);
+            }
+            break;
+        default:
+            ASSERT_EQ(lru.erase(key), position != positions.end());
+            if (position != positions.end())
+            {
+                order.erase(position->second);
+                positions.erase(position);
+            }
+            break;
+        }
+        ASSERT_EQ(lru.size(), order.size());
+    }
+    if (!order.empty())
+    {
+        EXPECT_EQ(lru.leastRecentKey(), order.back().first);
+    }
+}
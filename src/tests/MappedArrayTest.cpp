@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include "MappedArray.h"
+
+using ds::MapMode;
+using ds::MappedArray;
+
+class MappedArrayTest : public ::testing::Test
+{
+  protected:
+    std::string path;
+
+    void SetUp() override
+    {
+        char name[] = "/tmp/MappedArrayTestXXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    void writeFile(size_t n)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        for (uint32_t i = 0; i < n; i++)
+        {
+            std::fwrite(&i, sizeof(i), 1, file);
+        }
+        std::fclose(file);
+    }
+
+    long fileSize() const
+    {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        std::fseek(file, 0, SEEK_END);
+        long size = std::ftell(file);
+        std::fclose(file);
+        return size;
+    }
+};
+
+// --- Read-only ---
+TEST_F(MappedArrayTest, Constructor_ReadOnly_WhenFileExists_ShouldExposeItsElements)
+{
+    writeFile(1000);
+
+    MappedArray<uint32_t> array(path);
+
+    EXPECT_EQ(array.size(), 1000u);
+    EXPECT_EQ(array[0], 0u);
+    EXPECT_EQ(array[999], 999u);
+    EXPECT_EQ(array.at(500), 500u);
+}
+TEST_F(MappedArrayTest, Constructor_ReadOnly_WhenFileIsEmpty_ShouldCreateEmptyArray)
+{
+    MappedArray<uint32_t> array(path);
+
+    EXPECT_TRUE(array.isEmpty());
+    EXPECT_EQ(array.begin(), array.end());
+}
+TEST_F(MappedArrayTest, Constructor_WhenFileIsMissing_ShouldThrowRuntimeError)
+{
+    EXPECT_THROW(MappedArray<uint32_t>{path + ".missing"}, std::runtime_error);
+}
+TEST_F(MappedArrayTest, Constructor_WhenSizeIsNotAMultipleOfElementSize_ShouldThrowRuntimeError)
+{
+    writeFile(3);
+
+    EXPECT_THROW(MappedArray<uint64_t>{path}, std::runtime_error);
+}
+TEST_F(MappedArrayTest, At_WhenIndexOutOfBounds_ShouldThrowOutOfRange)
+{
+    writeFile(10);
+    MappedArray<uint32_t> array(path);
+
+    EXPECT_THROW(array.at(10), std::out_of_range);
+}
+TEST_F(MappedArrayTest, PushBack_WhenReadOnly_ShouldThrowRuntimeError)
+{
+    writeFile(10);
+    MappedArray<uint32_t> array(path);
+
+    EXPECT_THROW(array.pushBack(1), std::runtime_error);
+}
+TEST_F(MappedArrayTest, Iterators_WhenUsedWithAlgorithms_ShouldVisitAllElements)
+{
+    writeFile(100);
+    const MappedArray<uint32_t> array(path);
+
+    EXPECT_TRUE(std::is_sorted(array.begin(), array.end()));
+    EXPECT_EQ(array.end() - array.begin(), 100);
+    EXPECT_EQ(*std::find(array.cbegin(), array.cend(), 42u), 42u);
+}
+
+// --- Copy-on-write ---
+TEST_F(MappedArrayTest, Write_WhenCopyOnWrite_ShouldNotModifyFile)
+{
+    writeFile(10);
+    {
+        MappedArray<uint32_t> array(path, MapMode::CopyOnWrite);
+        array[3] = 100;
+        EXPECT_EQ(array[3], 100u);
+    }
+
+    MappedArray<uint32_t> reopened(path);
+    EXPECT_EQ(reopened[3], 3u);
+}
+
+// --- Read-write ---
+TEST_F(MappedArrayTest, PushBack_WhenReadWrite_ShouldGrowAndPersist)
+{
+    {
+        MappedArray<uint32_t> array(path, MapMode::ReadWrite);
+        for (uint32_t i = 0; i < 5000; i++)
+        {
+            array.pushBack(i);
+        }
+        EXPECT_EQ(array.size(), 5000u);
+        EXPECT_GE(array.capacity(), 5000u);
+        EXPECT_EQ(array[4999], 4999u);
+    }
+
+    EXPECT_EQ(fileSize(), static_cast<long>(5000 * sizeof(uint32_t)));
+    MappedArray<uint32_t> reopened(path);
+    ASSERT_EQ(reopened.size(), 5000u);
+    EXPECT_EQ(reopened[0], 0u);
+    EXPECT_EQ(reopened[4999], 4999u);
+}
+TEST_F(MappedArrayTest, Write_WhenReadWrite_ShouldModifyFile)
+{
+    writeFile(10);
+    {
+        MappedArray<uint32_t> array(path, MapMode::ReadWrite);
+        array[3] = 100;
+        array.sync();
+    }
+
+    MappedArray<uint32_t> reopened(path);
+    EXPECT_EQ(reopened[3], 100u);
+}
+TEST_F(MappedArrayTest, Resize_WhenGrowing_ShouldZeroNewElements)
+{
+    writeFile(2);
+    MappedArray<uint32_t> array(path, MapMode::ReadWrite);
+
+    array.resize(10);
+
+    EXPECT_EQ(array.size(), 10u);
+    EXPECT_EQ(array[1], 1u);
+    EXPECT_EQ(array[9], 0u);
+}
+TEST_F(MappedArrayTest, PopBack_WhenReadWrite_ShouldShrinkFileOnClose)
+{
+    writeFile(10);
+    {
+        MappedArray<uint32_t> array(path, MapMode::ReadWrite);
+        EXPECT_EQ(array.popBack(), 9u);
+    }
+
+    EXPECT_EQ(fileSize(), static_cast<long>(9 * sizeof(uint32_t)));
+}
+TEST_F(MappedArrayTest, MoveConstructor_WhenCalled_ShouldTransferMapping)
+{
+    writeFile(10);
+    MappedArray<uint32_t> array(path);
+
+    MappedArray<uint32_t> moved(std::move(array));
+
+    EXPECT_EQ(moved.size(), 10u);
+    EXPECT_EQ(moved[9], 9u);
+    EXPECT_TRUE(array.isEmpty());
+}
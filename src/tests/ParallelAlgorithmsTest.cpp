@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "ParallelAlgorithms.h"
+
+using ds::Array;
+using ds::ThreadPool;
+
+class ParallelAlgorithmsTest : public ::testing::Test
+{
+  protected:
+    void fill(size_t n)
+    {
+        uint32_t state = 12345;
+        for (size_t i = 0; i < n; i++)
+        {
+            state = state * 1664525u + 1013904223u;
+            array.pushBack(static_cast<int>(state % 100000));
+        }
+    }
+
+    ThreadPool pool{4};
+    Array<int> array;
+};
+
+// Small grain sizes force many tasks and several merge rounds on small inputs.
+TEST_F(ParallelAlgorithmsTest, Sort_WhenCalled_ShouldMatchStdSort)
+{
+    fill(100003);
+    Array<int> expected(array);
+    std::sort(expected.begin(), expected.end());
+
+    ds::parallel::sort(pool, array, std::less<int>(), 1000);
+
+    ASSERT_EQ(array.size(), expected.size());
+    for (size_t i = 0; i < array.size(); i++)
+    {
+        ASSERT_EQ(array[i], expected[i]);
+    }
+}
+TEST_F(ParallelAlgorithmsTest, Sort_WhenCustomComparator_ShouldSortDescending)
+{
+    fill(5000);
+
+    ds::parallel::sort(pool, array, std::greater<int>(), 100);
+
+    EXPECT_TRUE(std::is_sorted(array.begin(), array.end(), std::greater<int>()));
+}
+TEST_F(ParallelAlgorithmsTest, Sort_WhenNotTriviallyCopyable_ShouldSort)
+{
+    Array<std::string> strings;
+    for (int i = 0; i < 3000; i++)
+    {
+        strings.pushBack(std::to_string((i * 7919) % 3000));
+    }
+
+    ds::parallel::sort(pool, strings, std::less<std::string>(), 64);
+
+    EXPECT_TRUE(std::is_sorted(strings.begin(), strings.end()));
+    EXPECT_EQ(strings.size(), 3000u);
+}
+namespace
+{
+// Has no default constructor and counts live instances, to check that the merge buffer constructs
+// and destroys exactly what it moves.
+struct Tracked
+{
+    explicit Tracked(int iValue) : value(iValue)
+    {
+        alive++;
+    }
+
+    Tracked(const Tracked& other) : value(other.value)
+    {
+        alive++;
+    }
+
+    Tracked& operator=(const Tracked&) = default;
+
+    ~Tracked()
+    {
+        alive--;
+    }
+
+    bool operator<(const Tracked& other) const
+    {
+        return value < other.value;
+    }
+
+    static int alive;
+    int value;
+};
+
+int Tracked::alive = 0;
+} // namespace
+
+TEST_F(ParallelAlgorithmsTest, Sort_WhenUsingArenaAllocator_ShouldTakeMergeBufferFromArena)
+{
+    ds::Arena arena;
+    {
+        Array<Tracked, ds::ArenaAllocator<Tracked>> values{ds::ArenaAllocator<Tracked>(arena)};
+        values.reserve(3000);
+        for (int i = 0; i < 3000; i++)
+        {
+            values.emplaceBack((i * 7919) % 3000);
+        }
+        size_t usedBefore = arena.bytesUsed();
+
+        ds::parallel::sort(pool, values, std::less<Tracked>(), 64);
+
+        EXPECT_EQ(arena.bytesUsed() - usedBefore, 3000 * sizeof(Tracked));
+        EXPECT_EQ(Tracked::alive, 3000);
+        for (int i = 0; i < 3000; i++)
+        {
+            ASSERT_EQ(values[i].value, i);
+        }
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+}
+TEST_F(ParallelAlgorithmsTest, Sort_WhenSmallerThanGrain_ShouldSortSequentially)
+{
+    fill(10);
+
+    ds::parallel::sort(pool, array);
+
+    EXPECT_TRUE(std::is_sorted(array.begin(), array.end()));
+}
+TEST_F(ParallelAlgorithmsTest, Transform_WhenCalled_ShouldApplyFunctionToEveryElement)
+{
+    fill(10000);
+    Array<int64_t> doubled;
+
+    ds::parallel::transform(pool, array, doubled, [](int x) { return int64_t{x} * 2; }, 100);
+
+    ASSERT_EQ(doubled.size(), array.size());
+    for (size_t i = 0; i < array.size(); i++)
+    {
+        ASSERT_EQ(doubled[i], int64_t{array[i]} * 2);
+    }
+}
+TEST_F(ParallelAlgorithmsTest, Reduce_WhenCalled_ShouldMatchSequentialSum)
+{
+    fill(10007);
+    int64_t expected = 0;
+    for (int value : array)
+    {
+        expected += value;
+    }
+
+    int64_t total = ds::parallel::reduce(
+        pool, array, int64_t{0}, [](int64_t a, int64_t b) { return a + b; }, 100);
+
+    EXPECT_EQ(total, expected);
+}
+TEST_F(ParallelAlgorithmsTest, Reduce_WhenEmpty_ShouldReturnInit)
+{
+    EXPECT_EQ(ds::parallel::reduce(pool, array, 42, std::plus<int>()), 42);
+}
+TEST_F(ParallelAlgorithmsTest, ForEach_WhenCalled_ShouldVisitEveryElement)
+{
+    fill(10000);
+    Array<int> expected(array);
+
+    ds::parallel::forEach(pool, array, [](int& x) { x += 1; }, 100);
+
+    for (size_t i = 0; i < array.size(); i++)
+    {
+        ASSERT_EQ(array[i], expected[i] + 1);
+    }
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "RcuHashMap.h"
+
+using ds::RcuHashMap;
+
+class RcuHashMapTest : public ::testing::Test
+{
+  protected:
+    RcuHashMap<int, int> map{4};
+};
+
+TEST_F(RcuHashMapTest, Constructor_WhenCalled_ShouldConstructEmptyMap)
+{
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.reader().contains(1));
+}
+TEST_F(RcuHashMapTest, Insert_WhenKeyIsNew_ShouldBeVisibleToReaders)
+{
+    RcuHashMap<int, int>::Reader reader = map.reader();
+
+    map.insert(std::pair<const int, int>(1, 10));
+
+    EXPECT_EQ(reader.at(1), 10);
+    EXPECT_EQ(map.size(), 1u);
+}
+TEST_F(RcuHashMapTest, Insert_WhenKeyExists_ShouldThrowAndKeepValue)
+{
+    map.insert(std::pair<const int, int>(1, 10));
+
+    EXPECT_THROW(map.insert(std::pair<const int, int>(1, 20)), std::runtime_error);
+    EXPECT_EQ(map.reader().at(1), 10);
+}
+TEST_F(RcuHashMapTest, At_WhenKeyIsMissing_ShouldThrowOutOfRange)
+{
+    RcuHashMap<int, int>::Reader reader = map.reader();
+
+    EXPECT_THROW(reader.at(1), std::out_of_range);
+    EXPECT_FALSE(reader.contains(1));
+}
+TEST_F(RcuHashMapTest, InsertOrAssign_WhenCalled_ShouldReportWhetherKeyWasNew)
+{
+    EXPECT_TRUE(map.insertOrAssign(1, 10));
+    EXPECT_FALSE(map.insertOrAssign(1, 20));
+
+    EXPECT_EQ(map.reader().at(1), 20);
+}
+TEST_F(RcuHashMapTest, Erase_WhenCalled_ShouldReportWhetherKeyWasPresent)
+{
+    map.insertOrAssign(1, 10);
+
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_TRUE(map.isEmpty());
+}
+TEST_F(RcuHashMapTest, Clear_WhenCalled_ShouldEmptyMap)
+{
+    for (int i = 0; i < 100; i++)
+    {
+        map.insertOrAssign(i, i);
+    }
+
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+}
+TEST_F(RcuHashMapTest, Update_WhenFunctionThrows_ShouldPublishNothing)
+{
+    EXPECT_THROW(map.update([](RcuHashMap<int, int>::Table& table) {
+        table[1] = 10;
+        throw std::logic_error("failed");
+    }),
+                 std::logic_error);
+
+    EXPECT_TRUE(map.isEmpty());
+}
+TEST_F(RcuHashMapTest, Reader_WhenAllSlotsTaken_ShouldThrow)
+{
+    std::vector<RcuHashMap<int, int>::Reader> readers;
+    for (int i = 0; i < 4; i++)
+    {
+        readers.push_back(map.reader());
+    }
+
+    EXPECT_THROW(map.reader(), std::runtime_error);
+    readers.pop_back();
+    EXPECT_NO_THROW(map.reader());
+}
+TEST_F(RcuHashMapTest, Snapshot_WhenNested_ShouldKeepReaderInsideUntilOutermostEnds)
+{
+    map.insertOrAssign(1, 10);
+    RcuHashMap<int, int>::Reader reader = map.reader();
+    RcuHashMap<int, int>::Snapshot outer = reader.snapshot();
+    {
+        RcuHashMap<int, int>::Snapshot inner = reader.snapshot();
+        EXPECT_EQ(inner.at(1), 10);
+    }
+    std::atomic<bool> written{false};
+
+    std::thread writer([&] {
+        map.insertOrAssign(1, 20);
+        written = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    EXPECT_FALSE(written.load());
+    EXPECT_EQ(outer.at(1), 10);
+    {
+        RcuHashMap<int, int>::Snapshot moved = std::move(outer);
+    }
+    writer.join();
+    EXPECT_EQ(reader.at(1), 20);
+}
+TEST_F(RcuHashMapTest, Snapshot_WhenRead_ShouldOnlyExposeConstEntries)
+{
+    map.insertOrAssign(1, 10);
+    map.insertOrAssign(2, 20);
+    RcuHashMap<int, int>::Reader reader = map.reader();
+    RcuHashMap<int, int>::Snapshot snapshot = reader.snapshot();
+
+    int sum = 0;
+    for (const auto& pair : snapshot)
+    {
+        sum += pair.second;
+    }
+
+    EXPECT_TRUE((std::is_same<decltype(snapshot.at(1)), const int&>::value));
+    EXPECT_TRUE((std::is_same<decltype(snapshot.find(1)),
+                              const RcuHashMap<int, int>::ValueType*>::value));
+    EXPECT_EQ(snapshot.size(), 2u);
+    EXPECT_EQ(snapshot.find(2)->second, 20);
+    EXPECT_EQ(snapshot.find(3), nullptr);
+    EXPECT_TRUE(snapshot.contains(1));
+    EXPECT_EQ(sum, 30);
+}
+TEST_F(RcuHashMapTest, Update_WhenReadConcurrently_ShouldNeverExposePartialVersion)
+{
+    map.update([](RcuHashMap<int, int>::Table& table) {
+        for (int i = 0; i < 64; i++)
+        {
+            table[i] = 0;
+        }
+    });
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++)
+    {
+        readers.emplace_back([&] {
+            RcuHashMap<int, int>::Reader reader = map.reader();
+            while (!done.load())
+            {
+                RcuHashMap<int, int>::Snapshot snapshot = reader.snapshot();
+                int version = snapshot.at(0);
+                for (int i = 1; i < 64; i++)
+                {
+                    ASSERT_EQ(snapshot.at(i), version);
+                }
+            }
+        });
+    }
+
+    for (int version = 1; version <= 200; version++)
+    {
+        map.update([version](RcuHashMap<int, int>::Table& table) {
+            for (int i = 0; i < 64; i++)
+            {
+                table[i] = version;
+            }
+        });
+    }
+    done = true;
+    for (std::thread& thread : readers)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(map.reader().at(63), 200);
+}
+TEST_F(RcuHashMapTest, At_WhenKeyIsString_ShouldUseStringHasher)
+{
+    RcuHashMap<std::string, std::string> strings;
+
+    strings.insertOrAssign("Alice", "Engineer");
+
+    EXPECT_EQ(strings.reader().at("Alice"), "Engineer");
+}
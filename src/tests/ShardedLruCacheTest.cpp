@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ShardedLruCache.h"
+
+using ds::ShardedLruCache;
+
+class ShardedLruCacheTest : public ::testing::Test
+{
+  protected:
+    ShardedLruCache<int, int> cache{64, 4};
+};
+
+TEST_F(ShardedLruCacheTest, Constructor_WhenCalled_ShouldRoundShardsToPowerOfTwo)
+{
+    ShardedLruCache<int, int> other(100, 5);
+
+    EXPECT_EQ(other.shardCount(), 8u);
+    EXPECT_TRUE(other.isEmpty());
+}
+TEST_F(ShardedLruCacheTest, Get_WhenKeyIsCached_ShouldCopyValue)
+{
+    cache.put(1, 10);
+
+    int value = 0;
+    EXPECT_TRUE(cache.get(1, value));
+    EXPECT_EQ(value, 10);
+}
+TEST_F(ShardedLruCacheTest, Get_WhenKeyIsMissing_ShouldLeaveValueUntouched)
+{
+    int value = 5;
+
+    EXPECT_FALSE(cache.get(1, value));
+    EXPECT_EQ(value, 5);
+}
+TEST_F(ShardedLruCacheTest, Put_WhenOverCapacity_ShouldKeepEachShardWithinItsShare)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        cache.put(i, i);
+    }
+
+    EXPECT_LE(cache.size(), 64u);
+    EXPECT_GT(cache.size(), 32u);
+    EXPECT_TRUE(cache.contains(999));
+}
+TEST_F(ShardedLruCacheTest, Erase_WhenCalled_ShouldReportWhetherKeyWasCached)
+{
+    cache.put(1, 10);
+
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.erase(1));
+    EXPECT_FALSE(cache.contains(1));
+}
+TEST_F(ShardedLruCacheTest, Clear_WhenCalled_ShouldEmptyAllShards)
+{
+    for (int i = 0; i < 50; i++)
+    {
+        cache.put(i, i);
+    }
+
+    cache.clear();
+
+    EXPECT_TRUE(cache.isEmpty());
+}
+TEST_F(ShardedLruCacheTest, Operations_WhenMixedAcrossThreads_ShouldKeepValuesConsistent)
+{
+    ShardedLruCache<int, std::string> strings(1024, 8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 5000; i++)
+            {
+                int key = (t * 5000 + i) % 2048;
+                strings.put(key, std::to_string(key));
+                std::string value;
+                if (strings.get(key, value))
+                {
+                    EXPECT_EQ(value, std::to_string(key));
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_LE(strings.size(), 1024u);
+}
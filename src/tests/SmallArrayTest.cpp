@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "SmallArray.h"
+
+using ds::SmallArray;
+
+class SmallArrayTest : public ::testing::Test
+{
+  protected:
+    SmallArray<int, 4> array;
+};
+
+// --- Inline storage ---
+TEST_F(SmallArrayTest, Constructor_Default_WhenCalled_ShouldCreateEmptyInlineArray)
+{
+    EXPECT_TRUE(array.isEmpty());
+    EXPECT_TRUE(array.isInline());
+    EXPECT_EQ(array.capacity(), 4u);
+}
+TEST_F(SmallArrayTest, PushBack_WhenWithinInlineCapacity_ShouldStayInline)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        array.pushBack(i);
+    }
+
+    EXPECT_TRUE(array.isInline());
+    EXPECT_EQ(array.size(), 4u);
+    EXPECT_EQ(array[3], 3);
+}
+TEST_F(SmallArrayTest, PushBack_WhenInlineCapacityExceeded_ShouldMoveToHeap)
+{
+    for (int i = 0; i < 5; i++)
+    {
+        array.pushBack(i);
+    }
+
+    EXPECT_FALSE(array.isInline());
+    EXPECT_EQ(array.capacity(), 8u);
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(array[i], i);
+    }
+}
+TEST_F(SmallArrayTest, PushBack_WhenElementAliasesArray_ShouldCopyBeforeGrowing)
+{
+    SmallArray<std::string, 1> strings;
+    strings.pushBack("first");
+
+    strings.pushBack(strings[0]);
+
+    EXPECT_EQ(strings[1], "first");
+}
+
+// --- Element access ---
+TEST_F(SmallArrayTest, At_WhenOutOfRange_ShouldThrow)
+{
+    array.pushBack(0);
+
+    EXPECT_ANY_THROW(array.at(1));
+}
+TEST_F(SmallArrayTest, PopBack_WhenArrayEmpty_ShouldThrow)
+{
+    EXPECT_ANY_THROW(array.popBack());
+}
+TEST_F(SmallArrayTest, PopBack_WhenArrayHasMultipleElements_ShouldRemoveLast)
+{
+    array.pushBack(0);
+    array.pushBack(1);
+
+    EXPECT_EQ(array.popBack(), 1);
+    EXPECT_EQ(array.size(), 1u);
+}
+
+// --- Constructors and assignments ---
+TEST_F(SmallArrayTest, CopyConstructor_WhenInline_ShouldDuplicateElements)
+{
+    array.pushBack(0);
+    array.pushBack(1);
+
+    SmallArray<int, 4> copiedArray(array);
+
+    EXPECT_TRUE(copiedArray.isInline());
+    EXPECT_EQ(copiedArray[1], 1);
+}
+TEST_F(SmallArrayTest, MoveConstructor_WhenOnHeap_ShouldTransferOwnership)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        array.pushBack(i);
+    }
+
+    SmallArray<int, 4> movedArray(std::move(array));
+
+    EXPECT_EQ(movedArray.size(), 10u);
+    EXPECT_EQ(movedArray[9], 9);
+    EXPECT_TRUE(array.isEmpty());
+    EXPECT_TRUE(array.isInline());
+}
+TEST_F(SmallArrayTest, MoveAssignment_WhenInline_ShouldMoveElements)
+{
+    SmallArray<std::string, 2> strings;
+    strings.pushBack("a");
+
+    SmallArray<std::string, 2> movedStrings;
+    movedStrings = std::move(strings);
+
+    EXPECT_EQ(movedStrings[0], "a");
+    EXPECT_TRUE(strings.isEmpty());
+}
+TEST_F(SmallArrayTest, Swap_WhenOneInlineAndOneOnHeap_ShouldExchangeElements)
+{
+    SmallArray<int, 2> small;
+    small.pushBack(1);
+    SmallArray<int, 2> large;
+    for (int i = 0; i < 5; i++)
+    {
+        large.pushBack(i);
+    }
+
+    small.swap(large);
+
+    EXPECT_EQ(small.size(), 5u);
+    EXPECT_EQ(large.size(), 1u);
+    EXPECT_EQ(large[0], 1);
+    EXPECT_EQ(small[4], 4);
+}
+
+// --- Iterators ---
+TEST_F(SmallArrayTest, IteratorLoop_WhenIterating_ShouldVisitAllElementsInOrder)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        array.pushBack(i);
+    }
+
+    int i = 0;
+    for (int value : array)
+    {
+        EXPECT_EQ(value, i++);
+    }
+    EXPECT_EQ(i, 6);
+}
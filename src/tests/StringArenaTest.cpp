@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "StringArena.h"
+
+using ds::StringArena;
+using ds::StringRef;
+
+class StringArenaTest : public ::testing::Test
+{
+  protected:
+    StringArena arena;
+};
+
+TEST_F(StringArenaTest, Constructor_WhenCalled_ShouldCreateEmptyArena)
+{
+    EXPECT_EQ(arena.size(), 0u);
+}
+TEST_F(StringArenaTest, Append_WhenStringIsShort_ShouldUseOneBytePrefix)
+{
+    uint32_t offset = arena.append("Alice");
+
+    EXPECT_EQ(offset, 0u);
+    EXPECT_EQ(arena.size(), 6u);
+    EXPECT_EQ(arena.get(offset).str(), "Alice");
+}
+TEST_F(StringArenaTest, Append_WhenCalledRepeatedly_ShouldKeepEarlierOffsetsValid)
+{
+    uint32_t alice = arena.append("Alice");
+    for (int i = 0; i < 10000; i++)
+    {
+        arena.append(std::to_string(i));
+    }
+    uint32_t bob = arena.append(std::string("Bob"));
+
+    EXPECT_EQ(arena.get(alice).str(), "Alice");
+    EXPECT_EQ(arena.get(bob).str(), "Bob");
+}
+TEST_F(StringArenaTest, Append_WhenStringIsLong_ShouldStoreLengthOverSeveralBytes)
+{
+    std::string longString(100000, 'x');
+    longString[99999] = 'y';
+
+    uint32_t offset = arena.append(longString);
+
+    EXPECT_EQ(arena.size(), 100003u);
+    EXPECT_EQ(arena.get(offset).length, 100000u);
+    EXPECT_EQ(arena.get(offset).str(), longString);
+}
+TEST_F(StringArenaTest, Append_WhenStringHasNullBytes_ShouldKeepThem)
+{
+    std::string withNull("a\0b", 3);
+
+    uint32_t offset = arena.append(withNull);
+    uint32_t empty = arena.append("");
+
+    EXPECT_EQ(arena.get(offset).str(), withNull);
+    EXPECT_EQ(arena.get(empty).length, 0u);
+}
+TEST_F(StringArenaTest, StringRefEquality_ShouldCompareContent)
+{
+    std::string alice = "Alice";
+
+    EXPECT_TRUE(StringRef(alice) == StringRef("Alice"));
+    EXPECT_FALSE(StringRef("Alice") == StringRef("Alicia"));
+    EXPECT_FALSE(StringRef("Ali") == StringRef("Alice"));
+}
+TEST_F(StringArenaTest, Clear_WhenCalled_ShouldEmptyArena)
+{
+    arena.append("Alice");
+
+    arena.clear();
+
+    EXPECT_EQ(arena.size(), 0u);
+    EXPECT_EQ(arena.get(arena.append("Bob")).str(), "Bob");
+}
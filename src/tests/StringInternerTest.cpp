@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "StringInterner.h"
+
+using ds::StringInterner;
+
+class StringInternerTest : public ::testing::Test
+{
+  protected:
+    StringInterner interner;
+};
+
+TEST_F(StringInternerTest, Intern_WhenStringsAreEqual_ShouldReturnSameId)
+{
+    uint32_t first = interner.intern("Alice");
+    uint32_t second = interner.intern(std::string("Alice"));
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(interner.size(), 1u);
+    EXPECT_EQ(interner.bytes(), 6u);
+}
+TEST_F(StringInternerTest, Intern_WhenStringsDiffer_ShouldReturnDistinctIds)
+{
+    uint32_t alice = interner.intern("Alice");
+    uint32_t bob = interner.intern("Bob");
+
+    EXPECT_NE(alice, bob);
+    EXPECT_EQ(interner.get(alice).str(), "Alice");
+    EXPECT_EQ(interner.get(bob).str(), "Bob");
+}
+TEST_F(StringInternerTest, Find_WhenStringWasNeverInterned_ShouldReturnNotFound)
+{
+    uint32_t alice = interner.intern("Alice");
+
+    EXPECT_EQ(interner.find("Alice"), alice);
+    EXPECT_EQ(interner.find("Bob"), StringInterner::NOT_FOUND);
+}
+TEST_F(StringInternerTest, Intern_WhenManyStrings_ShouldKeepIdsStable)
+{
+    uint32_t ids[5000];
+    for (int i = 0; i < 5000; i++)
+    {
+        ids[i] = interner.intern("key:" + std::to_string(i));
+    }
+
+    for (int i = 0; i < 5000; i++)
+    {
+        ASSERT_EQ(interner.intern("key:" + std::to_string(i)), ids[i]);
+        ASSERT_EQ(interner.get(ids[i]).str(), "key:" + std::to_string(i));
+    }
+    EXPECT_EQ(interner.size(), 5000u);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "ThreadPool.h"
+
+using ds::ThreadPool;
+
+class ThreadPoolTest : public ::testing::Test
+{
+  protected:
+    ThreadPool pool{4};
+};
+
+TEST_F(ThreadPoolTest, constructor_WhenCalled_ShouldStartRequestedThreads)
+{
+    EXPECT_EQ(pool.size(), 4u);
+}
+TEST_F(ThreadPoolTest, run_WhenCalled_ShouldRunEveryTaskOnce)
+{
+    std::atomic<int> calls[100] = {};
+
+    pool.run(100, [&](size_t i) { calls[i]++; });
+
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(calls[i].load(), 1);
+    }
+}
+TEST_F(ThreadPoolTest, run_WhenNested_ShouldComplete)
+{
+    std::atomic<int> total{0};
+
+    pool.run(8, [&](size_t) { pool.run(8, [&](size_t) { total++; }); });
+
+    EXPECT_EQ(total.load(), 64);
+}
+TEST_F(ThreadPoolTest, run_WhenTaskThrows_ShouldRethrowInCaller)
+{
+    EXPECT_THROW(pool.run(10,
+                          [](size_t i) {
+                              if (i == 5)
+                              {
+                                  throw std::runtime_error("task failed");
+                              }
+                          }),
+                 std::runtime_error);
+}
+TEST_F(ThreadPoolTest, run_WhenNoTasks_ShouldReturnImmediately)
+{
+    pool.run(0, [](size_t) { FAIL(); });
+}